@@ -292,9 +292,11 @@ config_string(
 config_option(KernelFastpath FASTPATH "Enable IPC fastpath" DEFAULT ON)
 
 config_option(
-    KernelExceptionFastpath EXCEPTION_FASTPATH "Enable exception fastpath"
+    KernelExceptionFastpath EXCEPTION_FASTPATH
+    "Enable exception fastpath. On RISC-V this covers VM faults, UnknownSyscall \
+    and UserException faults."
     DEFAULT OFF
-    DEPENDS "NOT KernelVerificationBuild; KernelSel4ArchAarch64"
+    DEPENDS "NOT KernelVerificationBuild; KernelFastpath; KernelSel4ArchAarch64 OR KernelArchRiscV"
 )
 
 config_string(
@@ -306,7 +308,38 @@ config_string(
 config_option(
     KernelSignalFastpath SIGNAL_FASTPATH "Enable notification signal fastpath"
     DEFAULT OFF
-    DEPENDS "KernelIsMCS; KernelFastpath; KernelSel4ArchAarch64; NOT KernelVerificationBuild"
+    DEPENDS
+        "KernelIsMCS; KernelFastpath; KernelSel4ArchAarch64 OR KernelArchRiscV; NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelSendFastpath SEND_FASTPATH "Enable IPC send fastpath for seL4_Send and seL4_NBSend"
+    DEFAULT OFF
+    DEPENDS "KernelFastpath; KernelArchRiscV; NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_string(
+    KernelRiscvFastMessageRegisters RISCV_FAST_MESSAGE_REGISTERS
+    "Number of message registers seL4_Send and seL4_NBSend pass in registers, \
+    exported to libsel4 as seL4_FastMessageRegisters. Valid range 4-10. MR0-MR3 \
+    are passed in a2-a5 and the rest in t1-t6, and the send fastpath takes messages \
+    of up to this length. Received messages are unchanged, message registers past \
+    MR3 are delivered in the IPC buffer. seL4_Call and seL4_ReplyRecv still pass \
+    four, as their fastpaths are in the Rust part of the kernel and only take \
+    messages of up to four message registers."
+    DEFAULT 4
+    DEPENDS "KernelSendFastpath"
+    UNQUOTE
+)
+
+config_option(
+    KernelWaitFastpath WAIT_FASTPATH
+    "Enable notification receive fastpath for seL4_Wait, seL4_NBWait and seL4_Poll. \
+    Only taken when the notification is already active, or when polling."
+    DEFAULT OFF
+    DEPENDS "KernelFastpath; KernelArchRiscV; NOT KernelVerificationBuild"
     DEFAULT_DISABLED OFF
 )
 
@@ -341,6 +374,176 @@ else()
     config_set(KernelEnableSMPSupport ENABLE_SMP_SUPPORT OFF)
 endif()
 
+config_option(
+    KernelCrossCoreFastpath CROSSCORE_FASTPATH
+    "Complete Signal to a thread on another core on the fastpath. The signal is \
+    delivered locally and the other core is woken with a reschedule IPI if it has \
+    to run the receiver. Cross-core Call stays on the slowpath: the caller blocks, \
+    so a Call fastpath would still have to run the scheduler. With the \
+    utilisation benchmarks the kernel cycles of these Signals are counted, to \
+    compare with the Signal entries the kernel entry log records with this \
+    option off."
+    DEFAULT OFF
+    DEPENDS "KernelFastpath; KernelEnableSMPSupport; KernelArchRiscV; NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelFineGrainedLocking FINE_GRAINED_LOCKING
+    "Run the send and wait fastpaths without the big kernel lock. They hold a \
+    per-core shared lock, which the big kernel lock waits for, and a lock for \
+    the endpoint or notification they use, so that fastpaths on different \
+    objects run in parallel. Everything else still takes the big kernel lock. \
+    The lock order is documented in include/smp/lock.h. Not available with the \
+    kernel entry and utilisation benchmarks, whose entry state is shared by all \
+    cores. The generic benchmarks report the fastpaths run under the shared lock \
+    and the waits for the big kernel lock."
+    DEFAULT OFF
+    DEPENDS
+        "KernelEnableSMPSupport; NOT KernelIsMCS; NOT KernelCrossCoreFastpath; KernelSendFastpath OR KernelWaitFastpath; NOT KernelBenchmarksTrackKernelEntries; NOT KernelBenchmarksTrackUtilisation"
+    DEFAULT_DISABLED OFF
+)
+
+config_string(
+    KernelObjectLockBits OBJECT_LOCK_BITS
+    "log2 of the number of locks that endpoints and notifications are hashed to"
+    DEFAULT 6
+    DEPENDS "KernelFineGrainedLocking"
+    UNQUOTE
+)
+
+config_option(
+    KernelFastpathCapCache FASTPATH_CAP_CACHE
+    "Cache the slots found by the fastpath capability lookups of each thread, keyed \
+    by the cptr. The caches of all threads are flushed when a CNode or a TCB is \
+    invoked, as only those invocations delete, move or replace caps or change a \
+    CSpace root, and by Send and NBSend on the slowpath, which may invoke one \
+    without a fastpath lookup. Other syscalls, faults and interrupts keep them. \
+    Hits and misses are reported by the utilisation benchmark."
+    DEFAULT OFF
+    DEPENDS
+        "KernelFastpath; NOT KernelEnableSMPSupport; KernelArchRiscV; NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_string(
+    KernelFastpathCapCacheBits FASTPATH_CAP_CACHE_BITS
+    "log2 of the number of entries in the fastpath capability lookup cache of a \
+    thread. Each entry takes two words of the TCB."
+    DEFAULT 1
+    DEPENDS "KernelFastpathCapCache"
+    UNQUOTE
+)
+
+config_option(
+    KernelBatchInvocation BATCH_INVOCATION
+    "Add seL4_BatchInvoke, which performs the invocations queued on a ring in a \
+    user frame in one kernel entry, writing each reply back to its ring entry."
+    DEFAULT OFF
+    DEPENDS "NOT KernelIsMCS; KernelArchRiscV; NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelAsyncExecutor ASYNC_EXECUTOR
+    "Add seL4_AsyncSubmit, which queues a batch ring on the core of an executor \
+    thread and returns without waiting. The core performs the invocations on behalf \
+    of the executor and sets the uintr_flag in its IPC buffer once the ring is empty. \
+    No user interrupt is raised for it, the submitter polls the flag. \
+    Only untyped, frame, page table, ASID and IRQ handler caps can be invoked from \
+    an executor. Executors on the submitting core start at its next timer tick, \
+    executors on another core are started with an IPI. Executors with entries left \
+    past their budget continue at the next timer tick or IPI taken by their core."
+    DEFAULT OFF
+    DEPENDS "KernelIsAsync; KernelBatchInvocation"
+    DEFAULT_DISABLED OFF
+)
+
+config_string(
+    KernelAsyncExecutorQueueLength ASYNC_EXECUTOR_QUEUE_LENGTH
+    "Number of executors that can be queued on each core"
+    DEFAULT 8
+    DEPENDS "KernelAsyncExecutor"
+    UNQUOTE
+)
+
+config_string(
+    KernelAsyncExecutorBudget ASYNC_EXECUTOR_BUDGET
+    "Number of ring entries an executor completes before the core moves on to the \
+    next executor or returns to user level"
+    DEFAULT 16
+    DEPENDS "KernelAsyncExecutor"
+    UNQUOTE
+)
+
+config_option(
+    KernelWorkStealing WORK_STEALING
+    "Let an idle core pull a thread marked migratable with seL4_TCB_SetMigratable \
+    from the ready queue of a busy core. Busy cores kick an idle core with a \
+    reschedule IPI on fastpath exits and timer ticks, and the idle core migrates \
+    the highest priority migratable thread that is waiting behind the current \
+    thread of another core. The invocation is decoded in C on the Call, Send \
+    and NBSend entries, before the fastpaths and the slowpath."
+    DEFAULT OFF
+    DEPENDS "KernelEnableSMPSupport; NOT KernelIsMCS; KernelArchRiscV; NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelLocalSyscalls LOCAL_SYSCALLS
+    "Run syscalls that only touch the current thread and the state of the current \
+    core without taking big_kernel_lock. These are seL4_GetClock, \
+    seL4_BenchmarkNullSyscall, seL4_SetTLSBase, and seL4_Yield when nothing else \
+    is ready on the core. Not available with the kernel entry and utilisation \
+    benchmarks, whose entry state is shared by all cores. The generic benchmarks \
+    count the syscalls run this way and the big kernel lock acquisitions."
+    DEFAULT OFF
+    DEPENDS "KernelEnableSMPSupport; NOT KernelIsMCS; KernelArchRiscV; NOT KernelBenchmarksTrackKernelEntries; NOT KernelBenchmarksTrackUtilisation; NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelWakeupInbox WAKEUP_INBOX
+    "Have the C sources of the kernel wake threads with affinity to another core \
+    by pushing them onto a lock-free inbox of that core, instead of writing to \
+    its ready queues. The first push onto an empty inbox sends the core a \
+    reschedule IPI. The core splices the inbox into its own ready queues when it \
+    handles the IPI, on timer ticks, and on every other entry through C that \
+    takes big_kernel_lock. The inbox only covers the C callers. sendIPC, \
+    sendSignal and possibleSwitchTo in the Rust part of the kernel still write \
+    to the ready queues of other cores directly, so the ready queues are still \
+    shared between cores, and the splice skips threads already queued that way."
+    DEFAULT OFF
+    DEPENDS "KernelEnableSMPSupport; NOT KernelIsMCS; KernelArchRiscV; NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelTargetedRemoteCalls TARGETED_REMOTE_CALLS
+    "Queue remote calls on a per-core queue instead of passing them through \
+    shared arguments and a barrier of all cores involved. A synchronous remote \
+    call waits only for its targets to complete it, and the targets don't wait \
+    for the caller."
+    DEFAULT OFF
+    DEPENDS "KernelEnableSMPSupport; KernelArchRiscV; NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelIrqAffinity IRQ_AFFINITY
+    "Add seL4_IRQHandler_SetAffinity, which routes the interrupt of an IRQ \
+    handler to the given core. Without it an interrupt is delivered to whichever \
+    core last unmasked it, which is not necessarily the core running its driver. \
+    SetAffinity, and Ack for a routed interrupt, are decoded in C on the Call, \
+    Send and NBSend entries, before the fastpaths and the slowpath. Ack \
+    completes a routed interrupt in the PLIC context of the core it is routed \
+    to, whichever core acks it. Deleting the IRQ handler of a routed interrupt \
+    masks it on that core and drops the affinity."
+    DEFAULT OFF
+    DEPENDS "KernelEnableSMPSupport; KernelArchRiscV; NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
 config_string(
     KernelStackBits KERNEL_STACK_BITS
     "This describes the log2 size of the kernel stack. Great care should be taken as\
@@ -362,6 +565,45 @@ config_string(
     UNQUOTE
 )
 
+config_option(
+    KernelFPUDirtyTracking FPU_DIRTY_TRACKING
+    "Only save the FPU state of the current owner when switching it out if it was \
+    modified since it was last loaded or saved, as reported by sstatus.FS on kernel \
+    entry. The FPU is still switched lazily, on the first FPU instruction of a \
+    thread after another one used it. There is no eager mode, as context switches \
+    are done by the Rust part of the kernel, which this option does not change."
+    DEFAULT OFF
+    DEPENDS "KernelHaveFPU; KernelArchRiscV"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelRiscvExtV RISCV_EXT_V
+    "RISC-V vector extension. Threads opt in with seL4_SetVectorState, and the vector \
+    registers are switched lazily on the first vector instruction after another thread \
+    used them."
+    DEFAULT OFF
+    DEPENDS "KernelArchRiscV; KernelSel4ArchRiscV64; NOT KernelEnableSMPSupport"
+    DEFAULT_DISABLED OFF
+)
+
+config_string(
+    KernelRiscvVlenb RISCV_VLENB
+    "Length of a vector register in bytes, as read from the vlenb CSR"
+    DEFAULT 16
+    DEPENDS "KernelRiscvExtV"
+    UNQUOTE
+)
+
+config_string(
+    KernelRiscvVectorThreads RISCV_VECTOR_THREADS
+    "Number of threads that can have a vector state frame at the same time. The\
+    kernel keeps a copy of the frame capability of each of them."
+    DEFAULT 8
+    DEPENDS "KernelRiscvExtV"
+    UNQUOTE
+)
+
 config_option(
     KernelVerificationBuild VERIFICATION_BUILD
     "When enabled this configuration option prevents the usage of any other options that\
@@ -419,6 +661,7 @@ config_choice(
     This is not fully implemented for x86. \
     none -> No Benchmarking features enabled. \
     generic -> Enable global benchmarks config variable with no specific features. \
+    On SMP, also count big_kernel_lock acquisitions and waiting per core. \
     track_kernel_entries -> Log kernel entries information including timing, number of invocations and arguments for \
     system calls, interrupts, user faults and VM faults. \
     tracepoints -> Enable manually inserted tracepoints that the kernel will track time consumed between. \
@@ -556,6 +799,31 @@ config_string(
     DEPENDS "KernelIsMCS" UNDEF_DISABLED
 )
 
+config_option(
+    KernelReleaseHeap RELEASE_HEAP
+    "Keep the threads waiting for a refill in a binary heap ordered by the \
+    release time of their head refill, instead of a sorted list. Inserting \
+    and removing a thread is then O(log n) in the number of waiting threads \
+    on the core rather than O(n), but threads released at the same time are \
+    no longer woken in the order they were postponed."
+    DEFAULT OFF
+    DEPENDS "KernelIsMCS"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelReleaseSlack RELEASE_SLACK
+    "Allow each scheduling context to be given a slack, in microseconds, in \
+    the upper bits of the flags of SchedControl_ConfigureFlags. The release \
+    of a scheduling context may be delayed by up to its slack, so that the \
+    releases falling within it share a single timer interrupt. The slack is \
+    kept in one refill slot of the scheduling context, so each scheduling \
+    context can hold one refill less."
+    DEFAULT OFF
+    DEPENDS "KernelIsMCS"
+    DEFAULT_DISABLED OFF
+)
+
 config_option(
     KernelClz32 CLZ_32 "Define a __clzsi2 function to count leading zeros for uint32_t arguments. \
                         Only needed on platforms which lack a builtin instruction."
@@ -0,0 +1,14 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <config.h>
+#include <api/failures.h>
+#include <object/structures.h>
+
+#ifdef CONFIG_BATCH_INVOCATION
+exception_t batch_invoke(tcb_t *thread, word_t *buffer, seL4_BatchEntry *entry, bool_t fromExecutor);
+exception_t handle_SysBatchInvoke(void);
+#endif /* CONFIG_BATCH_INVOCATION */
@@ -0,0 +1,17 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <config.h>
+#include <api/failures.h>
+#include <object/structures.h>
+
+#ifdef CONFIG_ASYNC_EXECUTOR
+/* Runs the executors queued on the current core. Called on every timer tick
+ * and from the reschedule and async syscall IPIs. */
+void executorQueueDrain(void);
+void executorQueueRemove(tcb_t *tcb);
+exception_t handle_SysAsyncSubmit(void);
+#endif /* CONFIG_ASYNC_EXECUTOR */
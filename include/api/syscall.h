@@ -34,6 +34,12 @@ exception_t handleInterruptEntry(void);
 exception_t handleUnknownSyscall(word_t w);
 exception_t handleUserLevelFault(word_t w_a, word_t w_b);
 exception_t handleVMFaultEvent(vm_fault_type_t vm_faultType);
+#ifndef CONFIG_KERNEL_MCS
+exception_t handleInvocation(bool_t isCall, bool_t isBlocking);
+#endif
+#ifdef CONFIG_LOCAL_SYSCALLS
+bool_t handleLocalSyscall(syscall_t syscall);
+#endif
 
 
 word_t PURE getSyscallArg(word_t i, word_t *ipc_buffer);
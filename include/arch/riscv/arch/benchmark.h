@@ -17,6 +17,10 @@ static inline timestamp_t timestamp(void)
     return riscv_read_cycle();
 }
 
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+extern word_t ksTrapEntryCycles[CONFIG_MAX_NUM_NODES];
+#endif
+
 static inline void benchmark_arch_utilisation_reset(void)
 {
     /* nothing here */
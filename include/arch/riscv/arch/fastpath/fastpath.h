@@ -15,7 +15,12 @@
 #include <api/types.h>
 #include <smp/lock.h>
 #include <arch/machine/hardware.h>
+#include <arch/machine.h>
+#include <arch/kernel/vspace.h>
 #include <machine/fpu.h>
+#ifdef CONFIG_WORK_STEALING
+#include <model/smp.h>
+#endif
 
 void slowpath(syscall_t syscall)
     NORETURN;
@@ -33,6 +38,74 @@ static inline
 #endif
         NORETURN;
 
+#ifdef CONFIG_SEND_FASTPATH
+void fastpath_send(word_t cptr, word_t msgInfo, syscall_t syscall)
+NORETURN;
+#endif
+
+#ifdef CONFIG_SIGNAL_FASTPATH
+void fastpath_signal(word_t cptr, word_t msgInfo)
+NORETURN;
+#endif
+
+#ifdef CONFIG_WAIT_FASTPATH
+void fastpath_wait(word_t cptr, word_t msgInfo, syscall_t syscall)
+NORETURN;
+#endif
+
+#ifdef CONFIG_EXCEPTION_FASTPATH
+void fastpath_vm_fault(vm_fault_type_t type)
+NORETURN;
+
+void fastpath_unknown_syscall(syscall_t syscall)
+NORETURN;
+
+void fastpath_user_exception(word_t number)
+NORETURN;
+
+void vm_fault_slowpath(vm_fault_type_t type)
+NORETURN;
+
+void user_exception_slowpath(void)
+NORETURN;
+
+/* Same fault encoding as handleVMFault */
+static inline void fastpath_set_tcbfault_vm_fault(vm_fault_type_t type)
+{
+    word_t addr = read_stval();
+
+    switch (type) {
+    case RISCVLoadPageFault:
+    case RISCVLoadAccessFault:
+        NODE_STATE(ksCurThread)->tcbFault = seL4_Fault_VMFault_new(addr, RISCVLoadAccessFault, false);
+        break;
+    case RISCVStorePageFault:
+    case RISCVStoreAccessFault:
+        NODE_STATE(ksCurThread)->tcbFault = seL4_Fault_VMFault_new(addr, RISCVStoreAccessFault, false);
+        break;
+    case RISCVInstructionPageFault:
+    case RISCVInstructionAccessFault:
+        NODE_STATE(ksCurThread)->tcbFault = seL4_Fault_VMFault_new(addr, RISCVInstructionAccessFault, true);
+        break;
+    default:
+        fail("Invalid VM fault type");
+    }
+}
+#endif
+
+#ifdef CONFIG_RISCV_FAST_MESSAGE_REGISTERS
+/* Copy the message registers past n_msgRegisters to the receiver's IPC buffer,
+ * as the receive side of the ABI is unchanged */
+static inline void fastpath_copy_fast_mrs(word_t length, tcb_t *src, word_t *dest_buf)
+{
+    word_t i;
+
+    for (i = n_msgRegisters; i < length; i++) {
+        dest_buf[i + 1] = getRegister(src, fastMsgRegisters[i - n_msgRegisters]);
+    }
+}
+#endif
+
 /* Use macros to not break verification */
 #define endpoint_ptr_get_epQueue_tail_fp(ep_ptr) TCB_PTR(endpoint_ptr_get_epQueue_tail(ep_ptr))
 #define cap_vtable_cap_get_vspace_root_fp(vtable_cap) PTE_PTR(cap_page_table_cap_get_capPTBasePtr(vtable_cap))
@@ -78,6 +151,16 @@ void mdb_node_ptr_set_mdbPrev_np(mdb_node_t *node_ptr, word_t mdbPrev);
 // {
 //     return (msgInfo & MASK(seL4_MsgLengthBits + seL4_MsgExtraCapBits)) > 4;
 // }
+
+/* fastpath_send also takes the message registers passed in fastMsgRegisters */
+static inline int fastpath_send_mi_check(word_t msgInfo)
+{
+#ifdef CONFIG_RISCV_FAST_MESSAGE_REGISTERS
+    return (msgInfo & MASK(seL4_MsgLengthBits + seL4_MsgExtraCapBits)) > CONFIG_RISCV_FAST_MESSAGE_REGISTERS;
+#else
+    return fastpath_mi_check(msgInfo);
+#endif
+}
 void fastpath_copy_mrs(word_t length, tcb_t *src, tcb_t *dest);
 // static inline void fastpath_copy_mrs(word_t length, tcb_t *src, tcb_t *dest)
 // {
@@ -101,6 +184,13 @@ void NORETURN fastpath_restore(word_t badge, word_t msgInfo, tcb_t *cur_thread);
 /** DONT_TRANSLATE */
 void NORETURN fastpath_restore(word_t badge, word_t msgInfo, tcb_t *cur_thread)
 {
+#ifdef CONFIG_WORK_STEALING
+    /* the fastpath never goes through the scheduler, so this is where a core
+     * switching between its own threads notices an idle core */
+    if (clh_is_self_in_queue()) {
+        stealKick();
+    }
+#endif
     NODE_UNLOCK_IF_HELD;
 
     word_t cur_thread_regs = (word_t)cur_thread->tcbArch.tcbContext.registers;
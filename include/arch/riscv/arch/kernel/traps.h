@@ -9,10 +9,26 @@
 
 #include <config.h>
 #include <util.h>
+#include <arch/machine/hardware.h>
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+#include <arch/benchmark.h>
+#include <model/statedata.h>
+#endif
+
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+/* The cycles spent in trap_entry for the current kernel entry */
+static inline word_t trap_entry_cycles(void)
+{
+    return (word_t)riscv_read_cycle() - ksTrapEntryCycles[CURRENT_CPU_INDEX()];
+}
+#endif
 
 static inline void arch_c_entry_hook(void)
 {
-    /* Nothing architecture specific to be done. */
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    NODE_STATE(benchmark_trap_entries)++;
+    NODE_STATE(benchmark_trap_entry_cycles) += trap_entry_cycles();
+#endif
 }
 
 static inline void arch_c_exit_hook(void)
@@ -30,12 +46,55 @@ VISIBLE NORETURN;
 void c_handle_fastpath_call(word_t cptr, word_t msgInfo)
 VISIBLE NORETURN;
 
+#if defined(CONFIG_SEND_FASTPATH) || defined(CONFIG_SIGNAL_FASTPATH)
+void c_handle_fastpath_send(word_t cptr, word_t msgInfo, syscall_t syscall)
+VISIBLE NORETURN;
+#endif
+
+#ifdef CONFIG_WAIT_FASTPATH
+void c_handle_fastpath_wait(word_t cptr, word_t msgInfo, syscall_t syscall)
+VISIBLE NORETURN;
+#endif
+
+#ifdef CONFIG_EXCEPTION_FASTPATH
+void c_handle_fastpath_unknown_syscall(word_t cptr, word_t msgInfo, syscall_t syscall)
+VISIBLE NORETURN;
+
+void c_handle_fastpath_exception(void)
+VISIBLE NORETURN;
+#endif
+
+#ifdef CONFIG_RISCV_EXT_V
+void c_handle_vector_exception(void)
+VISIBLE NORETURN;
+#endif
+
+#ifdef RISCV_C_INVOCATIONS
+void c_handle_invocation(word_t cptr, word_t msgInfo, syscall_t syscall)
+VISIBLE NORETURN;
+#endif
+
+#ifdef CONFIG_LOCAL_SYSCALLS
+void c_handle_local_syscall(word_t cptr, word_t msgInfo, syscall_t syscall)
+VISIBLE NORETURN;
+#endif
+
 void c_handle_syscall(word_t cptr, word_t msgInfo, syscall_t syscall)
 VISIBLE NORETURN;
 
 void c_handle_interrupt(void)
 VISIBLE NORETURN;
 
+#ifdef CONFIG_RISCV_IRQ_BATCH
+void c_handle_external_interrupt(void)
+VISIBLE NORETURN;
+#endif
+
+#ifdef RISCV_TIMER_ENTRY
+void c_handle_timer_interrupt(void)
+VISIBLE NORETURN;
+#endif
+
 void c_handle_exception(void)
 VISIBLE NORETURN;
 
@@ -275,6 +275,9 @@ void initTimer(void);
 void initLocalIRQController(void);
 void initIRQController(void);
 void setIRQTrigger(irq_t irq, bool_t trigger);
+#ifdef CONFIG_IRQ_PRIORITIES
+void setIRQPriority(irq_t irq, word_t prio);
+#endif
 
 #ifdef ENABLE_SMP_SUPPORT
 #define irq_remote_call_ipi     (INTERRUPT_IPI_0)
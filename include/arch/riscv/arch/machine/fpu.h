@@ -32,6 +32,9 @@ static inline void set_fs_off(void)
 #endif
 
 extern bool_t isFPUEnabledCached[CONFIG_MAX_NUM_NODES];
+#ifdef CONFIG_FPU_DIRTY_TRACKING
+extern word_t fpuStateDirty[CONFIG_MAX_NUM_NODES];
+#endif
 
 static inline void set_fs_clean(void)
 {
@@ -163,6 +166,20 @@ static inline bool_t isFpuEnable(void)
     return isFPUEnabledCached[CURRENT_CPU_INDEX()];
 }
 
+#ifdef CONFIG_FPU_DIRTY_TRACKING
+/* Only the owner of the FPU state can trap with FS dirty, so this tracks
+ * whether the active FPU state differs from its saved copy */
+static inline bool_t isFpuStateDirty(void)
+{
+    return fpuStateDirty[CURRENT_CPU_INDEX()];
+}
+
+static inline void clearFpuStateDirty(void)
+{
+    fpuStateDirty[CURRENT_CPU_INDEX()] = 0;
+}
+#endif
+
 static inline void set_tcb_fs_state(tcb_t *tcb, bool_t enabled)
 {
     word_t sstatus = getRegister(tcb, SSTATUS);
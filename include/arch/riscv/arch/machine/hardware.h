@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <config.h>
 #include <util.h>
 
 #include <mode/hardware.h>
@@ -20,11 +21,31 @@
 #define SSTATUS_FS_INITIAL  0x00002000
 #define SSTATUS_FS_DIRTY    0x00006000
 
+#define SSTATUS_VS    0x00000600
+
+#define SSTATUS_VS_CLEAN    0x00000400
+#define SSTATUS_VS_INITIAL  0x00000200
+#define SSTATUS_VS_DIRTY    0x00000600
+
 #define SATP_MODE_OFF  0
 #define SATP_MODE_SV32 1
 #define SATP_MODE_SV39 8
 #define SATP_MODE_SV48 9
 
+/* Timer interrupts enter the kernel through c_handle_timer_interrupt, which
+ * does per-tick work around the interrupt handling, or times it */
+#if defined(CONFIG_ASYNC_EXECUTOR) || defined(CONFIG_WORK_STEALING) || defined(CONFIG_WAKEUP_INBOX) || \
+    defined(CONFIG_BENCHMARK_TRACK_UTILISATION)
+#define RISCV_TIMER_ENTRY
+#endif
+
+/* Call, Send and NBSend enter the kernel through c_handle_invocation, which
+ * decodes the invocations the Rust part of the kernel doesn't know */
+#if defined(CONFIG_WORK_STEALING) || defined(CONFIG_IRQ_AFFINITY) || \
+    defined(CONFIG_IRQ_PRIORITIES)
+#define RISCV_C_INVOCATIONS
+#endif
+
 #ifndef __ASSEMBLER__
 
 #include <config.h>
@@ -81,6 +81,48 @@ static inline void plic_complete_claim(irq_t irq);
 static inline void plic_mask_irq(bool_t disable, irq_t irq);
 
 
+#ifdef ENABLE_SMP_SUPPORT
+/*
+ * This function is called to route an interrupt to the S-Mode context of the
+ * given hart. The interrupt stays masked or unmasked, and later masking,
+ * unmasking and claim completion act on that hart's context, whichever hart
+ * they are called on.
+ *
+ * @param[in]  irq      interrupt to route.
+ * @param[in]  hart_id  hart to deliver the interrupt to.
+ */
+static inline void plic_irq_set_affinity(irq_t irq, word_t hart_id);
+
+/*
+ * This function is called when the last IRQ handler cap of an interrupt is
+ * deleted. It masks the interrupt in the context it is routed to and drops
+ * the routing, so the interrupt is back in the state it was left in at boot
+ * and the next unmask enables it on the hart that does it.
+ *
+ * @param[in]  irq      interrupt to stop routing.
+ */
+static inline void plic_irq_clear_affinity(irq_t irq);
+#endif
+
+#ifdef CONFIG_IRQ_PRIORITIES
+/*
+ * This function returns the highest interrupt priority the PLIC implements.
+ * It is only valid after plic_init_controller has been called.
+ *
+ * @return     the highest priority, at least 1.
+ */
+static inline word_t plic_max_priority(void);
+
+/*
+ * This function is called to set the priority of an interrupt, between 1 and
+ * plic_max_priority().
+ *
+ * @param[in]  irq       interrupt to set the priority for.
+ * @param[in]  priority  priority of the interrupt.
+ */
+static inline void plic_irq_set_priority(irq_t irq, word_t priority);
+#endif /* CONFIG_IRQ_PRIORITIES */
+
 #ifdef HAVE_SET_TRIGGER
 /*
  * If HAVE_SET_TRIGGER is defined, this function is called to configure an
@@ -86,6 +86,9 @@ enum messageSizes {
 };
 
 extern const register_t msgRegisters[] VISIBLE;
+#ifdef CONFIG_RISCV_FAST_MESSAGE_REGISTERS
+extern const register_t fastMsgRegisters[] VISIBLE;
+#endif
 extern const register_t frameRegisters[] VISIBLE;
 extern const register_t gpRegisters[] VISIBLE;
 
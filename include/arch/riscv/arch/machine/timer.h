@@ -12,6 +12,9 @@
 #include <mode/util.h>
 #include <arch/sbi.h>
 #include <arch/machine/hardware.h>
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+#include <arch/benchmark.h>
+#endif
 
 /* The scheduler clock is greater than 1MHz */
 #define TICKS_IN_US (TIMER_CLOCK_HZ / (US_IN_MS * MS_IN_S))
@@ -57,8 +60,15 @@ static inline ticks_t getCurrentTime(void)
 static inline void setDeadline(ticks_t deadline)
 {
     assert(deadline > NODE_STATE(ksCurTime));
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    timestamp_t start = timestamp();
+#endif
     /* Setting the timer acknowledges any existing IRQs */
     sbi_set_timer(deadline);
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    NODE_STATE(benchmark_timer_program_cycles) += timestamp() - start;
+    NODE_STATE(benchmark_timer_programs)++;
+#endif
 }
 
 /* ack previous deadline irq */
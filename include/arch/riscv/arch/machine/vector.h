@@ -0,0 +1,133 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <config.h>
+
+#ifdef CONFIG_RISCV_EXT_V
+
+#include <types.h>
+#include <api/failures.h>
+#include <object/structures.h>
+#include <model/statedata.h>
+#include <machine/registerset.h>
+#include <arch/machine.h>
+#include <arch/machine/hardware.h>
+
+/* Layout of the vector state in the frame given to seL4_SetVectorState */
+typedef struct user_vector_state {
+    word_t vstart;
+    word_t vcsr;
+    word_t vl;
+    word_t vtype;
+    uint8_t regs[32 * CONFIG_RISCV_VLENB];
+} user_vector_state_t;
+
+#define VECTOR_GROUP_BYTES (8 * CONFIG_RISCV_VLENB)
+
+/* Vector instructions in the kernel need VS to be on in the live sstatus,
+ * which is replaced by the one of the thread on the way out */
+static inline void set_vs_clean(void)
+{
+    asm volatile("csrs sstatus, %0" :: "rK"(SSTATUS_VS_CLEAN));
+}
+
+static inline word_t read_vlenb(void)
+{
+    word_t vlenb;
+
+    set_vs_clean();
+    asm volatile(
+        ".option push\n\t"
+        ".option arch, +v\n\t"
+        "csrr %0, vlenb\n\t"
+        ".option pop"
+        : "=r"(vlenb));
+    return vlenb;
+}
+
+static inline void saveVectorState(user_vector_state_t *dest)
+{
+    uint8_t *regs = dest->regs;
+
+    set_vs_clean();
+    asm volatile(
+        ".option push\n\t"
+        ".option arch, +v\n\t"
+        "csrr %[vstart], vstart\n\t"
+        "csrr %[vcsr], vcsr\n\t"
+        "csrr %[vl], vl\n\t"
+        "csrr %[vtype], vtype\n\t"
+        /* whole register stores ignore vl and vtype, but not vstart */
+        "csrw vstart, zero\n\t"
+        "vs8r.v v0, (%[regs])\n\t"
+        "add %[regs], %[regs], %[step]\n\t"
+        "vs8r.v v8, (%[regs])\n\t"
+        "add %[regs], %[regs], %[step]\n\t"
+        "vs8r.v v16, (%[regs])\n\t"
+        "add %[regs], %[regs], %[step]\n\t"
+        "vs8r.v v24, (%[regs])\n\t"
+        ".option pop"
+        : [vstart] "=&r"(dest->vstart), [vcsr] "=&r"(dest->vcsr),
+        [vl] "=&r"(dest->vl), [vtype] "=&r"(dest->vtype), [regs] "+&r"(regs)
+        : [step] "r"(VECTOR_GROUP_BYTES)
+        : "memory"
+    );
+}
+
+static inline void loadVectorState(user_vector_state_t *src)
+{
+    uint8_t *regs = src->regs;
+
+    set_vs_clean();
+    asm volatile(
+        ".option push\n\t"
+        ".option arch, +v\n\t"
+        "csrw vstart, zero\n\t"
+        "vl8r.v v0, (%[regs])\n\t"
+        "add %[regs], %[regs], %[step]\n\t"
+        "vl8r.v v8, (%[regs])\n\t"
+        "add %[regs], %[regs], %[step]\n\t"
+        "vl8r.v v16, (%[regs])\n\t"
+        "add %[regs], %[regs], %[step]\n\t"
+        "vl8r.v v24, (%[regs])\n\t"
+        /* vl is at most VLMAX of the saved vtype, so this restores it as is */
+        "vsetvl zero, %[vl], %[vtype]\n\t"
+        "csrw vcsr, %[vcsr]\n\t"
+        "csrw vstart, %[vstart]\n\t"
+        ".option pop"
+        : [regs] "+&r"(regs)
+        : [step] "r"(VECTOR_GROUP_BYTES), [vl] "r"(src->vl), [vtype] "r"(src->vtype),
+        [vcsr] "r"(src->vcsr), [vstart] "r"(src->vstart)
+        : "memory"
+    );
+}
+
+static inline word_t get_tcb_vs_state(tcb_t *tcb)
+{
+    return getRegister(tcb, SSTATUS) & SSTATUS_VS;
+}
+
+static inline void set_tcb_vs_state(tcb_t *tcb, word_t vs)
+{
+    setRegister(tcb, SSTATUS, (getRegister(tcb, SSTATUS) & ~SSTATUS_VS) | vs);
+}
+
+/* Returns whether the thread has opted in to the vector extension, but does
+ * not have the vector registers, so that its next vector instruction traps */
+static inline bool_t vectorThreadCanFault(tcb_t *thread)
+{
+    return thread->tcbVectorState != NULL &&
+           get_tcb_vs_state(thread) == 0 &&
+           thread != NODE_STATE(ksActiveVectorOwner);
+}
+
+user_vector_state_t *lookupVectorState(tcb_t *thread);
+void switchVectorOwner(tcb_t *new_owner);
+void handleVectorFault(void);
+void vectorThreadDelete(tcb_t *thread);
+exception_t handle_SysSetVectorState(void);
+
+#endif /* CONFIG_RISCV_EXT_V */
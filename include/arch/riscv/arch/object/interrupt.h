@@ -21,3 +21,13 @@ exception_t Arch_decodeIRQControlInvocation(word_t invLabel, word_t length,
                                             cte_t *srcSlot, word_t *buffer);
 exception_t Arch_checkIRQ(word_t irq_w);
 
+#ifdef CONFIG_IRQ_AFFINITY
+exception_t decodeIRQHandlerSetAffinity(cap_t cap, word_t length, word_t *buffer);
+bool_t ackRoutedIRQ(irq_t irq);
+void clearIRQAffinity(irq_t irq);
+#endif
+
+#ifdef CONFIG_IRQ_PRIORITIES
+exception_t decodeIRQHandlerSetPriority(cap_t cap, word_t length, word_t *buffer);
+#endif
+
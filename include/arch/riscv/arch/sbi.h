@@ -72,6 +72,82 @@ static inline word_t sbi_call(word_t cmd,
 #define SBI_CALL_1(which, arg0) sbi_call(which, arg0, 0, 0)
 #define SBI_CALL_2(which, arg0, arg1) sbi_call(which, arg0, arg1, 0)
 
+#ifdef CONFIG_RISCV_SBI_EXTENSIONS
+/* Extensions of SBI v0.2 and later, which take the function in a6 and return
+ * an error and a value */
+#define SBI_EXT_BASE 0x10
+#define SBI_EXT_TIME 0x54494D45
+#define SBI_EXT_IPI 0x735049
+#define SBI_EXT_RFENCE 0x52464E43
+
+#define SBI_BASE_GET_SPEC_VERSION 0
+#define SBI_BASE_PROBE_EXTENSION 3
+#define SBI_TIME_SET_TIMER 0
+#define SBI_IPI_SEND_IPI 0
+#define SBI_RFENCE_FENCE_I 0
+#define SBI_RFENCE_SFENCE_VMA 1
+#define SBI_RFENCE_SFENCE_VMA_ASID 2
+
+#define SBI_SUCCESS 0
+
+/* What the boot hart found, see riscv_probe_sbi() */
+#define SBI_HAS_TIME BIT(0)
+#define SBI_HAS_IPI BIT(1)
+#define SBI_HAS_RFENCE BIT(2)
+#define RISCV_HAS_SSTC BIT(3)
+
+#define CSR_STIMECMP 0x14d
+#define CSR_STIMECMPH 0x15d
+
+extern word_t sbi_features;
+
+void riscv_probe_sbi(void);
+
+typedef struct sbi_ret {
+    word_t error;
+    word_t value;
+} sbi_ret_t;
+
+static inline sbi_ret_t sbi_ecall(word_t ext, word_t fid, word_t arg_0,
+                                  word_t arg_1, word_t arg_2, word_t arg_3,
+                                  word_t arg_4)
+{
+    register word_t a0 asm("a0") = arg_0;
+    register word_t a1 asm("a1") = arg_1;
+    register word_t a2 asm("a2") = arg_2;
+    register word_t a3 asm("a3") = arg_3;
+    register word_t a4 asm("a4") = arg_4;
+    register word_t a6 asm("a6") = fid;
+    register word_t a7 asm("a7") = ext;
+    asm volatile("ecall"
+                 : "+r"(a0), "+r"(a1)
+                 : "r"(a2), "r"(a3), "r"(a4), "r"(a6), "r"(a7)
+                 : "memory");
+    return (sbi_ret_t) {
+        .error = a0, .value = a1
+    };
+}
+
+static inline bool_t sbi_has(word_t feature)
+{
+    return (sbi_features & feature) != 0;
+}
+
+/* With Sstc the deadline goes straight into stimecmp, which also clears a
+ * pending timer interrupt */
+static inline void sstc_set_timer(uint64_t stime_value)
+{
+#if __riscv_xlen == 32
+    /* keep the comparison in the future while the halves are written */
+    asm volatile("csrw %0, %1" :: "i"(CSR_STIMECMP), "r"(~0ul));
+    asm volatile("csrw %0, %1" :: "i"(CSR_STIMECMPH), "r"((word_t)(stime_value >> 32)));
+    asm volatile("csrw %0, %1" :: "i"(CSR_STIMECMP), "r"((word_t)stime_value));
+#else
+    asm volatile("csrw %0, %1" :: "i"(CSR_STIMECMP), "r"(stime_value));
+#endif
+}
+#endif /* CONFIG_RISCV_SBI_EXTENSIONS */
+
 static inline void sbi_console_putchar(int ch)
 {
     SBI_CALL_1(SBI_CONSOLE_PUTCHAR, ch);
@@ -84,6 +160,20 @@ static inline int sbi_console_getchar(void)
 
 static inline void sbi_set_timer(unsigned long long stime_value)
 {
+#ifdef CONFIG_RISCV_SBI_EXTENSIONS
+    if (sbi_has(RISCV_HAS_SSTC)) {
+        sstc_set_timer(stime_value);
+        return;
+    }
+    if (sbi_has(SBI_HAS_TIME)) {
+#if __riscv_xlen == 32
+        sbi_ecall(SBI_EXT_TIME, SBI_TIME_SET_TIMER, stime_value, stime_value >> 32, 0, 0, 0);
+#else
+        sbi_ecall(SBI_EXT_TIME, SBI_TIME_SET_TIMER, stime_value, 0, 0, 0, 0);
+#endif
+        return;
+    }
+#endif
 #if __riscv_xlen == 32
     SBI_CALL_2(SBI_SET_TIMER, stime_value, stime_value >> 32);
 #else
@@ -105,6 +195,13 @@ static inline void sbi_clear_ipi(void)
 
 static inline void sbi_send_ipi(word_t hart_mask)
 {
+#ifdef CONFIG_RISCV_SBI_EXTENSIONS
+    /* The v0.2 extensions pass the mask by value, relative to a base hart */
+    if (sbi_has(SBI_HAS_IPI)) {
+        sbi_ecall(SBI_EXT_IPI, SBI_IPI_SEND_IPI, hart_mask, 0, 0, 0, 0);
+        return;
+    }
+#endif
     /* ToDo: In the legacy SBI API the hart mask parameter is not a value, but
      *       the virtual address of a bit vector. This was intended to allow
      *       passing an arbitrary number of harts without being limited by the
@@ -130,6 +227,12 @@ static inline void sbi_send_ipi(word_t hart_mask)
 
 static inline void sbi_remote_fence_i(word_t hart_mask)
 {
+#ifdef CONFIG_RISCV_SBI_EXTENSIONS
+    if (sbi_has(SBI_HAS_RFENCE)) {
+        sbi_ecall(SBI_EXT_RFENCE, SBI_RFENCE_FENCE_I, hart_mask, 0, 0, 0, 0);
+        return;
+    }
+#endif
     /* See comment at sbi_send_ipi() about the pointer parameter. */
     word_t virt_addr_hart_mask = (word_t)&hart_mask;
     SBI_CALL_1(SBI_REMOTE_FENCE_I, virt_addr_hart_mask);
@@ -139,6 +242,12 @@ static inline void sbi_remote_sfence_vma(word_t hart_mask,
                                          unsigned long start,
                                          unsigned long size)
 {
+#ifdef CONFIG_RISCV_SBI_EXTENSIONS
+    if (sbi_has(SBI_HAS_RFENCE)) {
+        sbi_ecall(SBI_EXT_RFENCE, SBI_RFENCE_SFENCE_VMA, hart_mask, 0, start, size, 0);
+        return;
+    }
+#endif
     /* See comment at sbi_send_ipi() about the pointer parameter. */
     word_t virt_addr_hart_mask = (word_t)&hart_mask;
     SBI_CALL_1(SBI_REMOTE_SFENCE_VMA, virt_addr_hart_mask);
@@ -149,6 +258,12 @@ static inline void sbi_remote_sfence_vma_asid(word_t hart_mask,
                                               unsigned long size,
                                               unsigned long asid)
 {
+#ifdef CONFIG_RISCV_SBI_EXTENSIONS
+    if (sbi_has(SBI_HAS_RFENCE)) {
+        sbi_ecall(SBI_EXT_RFENCE, SBI_RFENCE_SFENCE_VMA_ASID, hart_mask, 0, start, size, asid);
+        return;
+    }
+#endif
     /* See comment at sbi_send_ipi() about the pointer parameter. */
     word_t virt_addr_hart_mask = (word_t)&hart_mask;
     SBI_CALL_1(SBI_REMOTE_SFENCE_VMA_ASID, virt_addr_hart_mask);
@@ -121,6 +121,27 @@ static inline word_t plic_get_current_hart_id(void)
                CONFIG_FIRST_HART_ID);
 }
 
+#ifdef ENABLE_SMP_SUPPORT
+/* The hart each IRQ is routed to plus one, zero leaves it with the hart that
+ * unmasks it */
+static word_t plic_irq_affinity[PLIC_NUM_INTERRUPTS + 1];
+
+static inline bool_t plic_irq_is_routed(irq_t irq)
+{
+    return plic_irq_affinity[irq] != 0;
+}
+#endif
+
+static inline word_t plic_irq_hart_id(irq_t irq)
+{
+#ifdef ENABLE_SMP_SUPPORT
+    if (plic_irq_affinity[irq] != 0) {
+        return plic_irq_affinity[irq] - 1;
+    }
+#endif
+    return plic_get_current_hart_id();
+}
+
 static inline irq_t plic_get_claim(void)
 {
     /* Read the claim register for our HART interrupt context */
@@ -130,18 +151,19 @@ static inline irq_t plic_get_claim(void)
 
 static inline void plic_complete_claim(irq_t irq)
 {
-    /* Complete the IRQ claim by writing back to the claim register. */
-    word_t hart_id = plic_get_current_hart_id();
+    /* Complete the IRQ claim by writing back to the claim register. The PLIC
+     * ignores completions from a context the IRQ isn't enabled in, so this
+     * has to be the context it is routed to rather than the current one. */
+    word_t hart_id = plic_irq_hart_id(irq);
     writel(irq, PLIC_PPTR_BASE + plic_claim_offset(hart_id, PLIC_SVC_CONTEXT));
 }
 
-static inline void plic_mask_irq(bool_t disable, irq_t irq)
+static inline void plic_hart_mask_irq(bool_t disable, irq_t irq, word_t hart_id)
 {
     word_t addr = 0;
     uint32_t val = 0;
     uint32_t bit = 0;
 
-    word_t hart_id = plic_get_current_hart_id();
     addr = PLIC_PPTR_BASE + plic_enable_offset(hart_id, PLIC_SVC_CONTEXT) + (irq / 32) * 4;
     bit = irq % 32;
 
@@ -154,6 +176,70 @@ static inline void plic_mask_irq(bool_t disable, irq_t irq)
     writel(val, addr);
 }
 
+static inline void plic_mask_irq(bool_t disable, irq_t irq)
+{
+    plic_hart_mask_irq(disable, irq, plic_irq_hart_id(irq));
+}
+
+#ifdef ENABLE_SMP_SUPPORT
+static inline bool_t plic_hart_irq_enabled(irq_t irq, word_t hart_id)
+{
+    word_t addr = PLIC_PPTR_BASE + plic_enable_offset(hart_id, PLIC_SVC_CONTEXT) + (irq / 32) * 4;
+
+    return !!(readl(addr) & BIT(irq % 32));
+}
+
+static inline void plic_irq_set_affinity(irq_t irq, word_t hart_id)
+{
+    bool_t enabled = false;
+    word_t cpu, old_hart_id;
+
+    /* Without an affinity the IRQ is enabled in the context of whichever
+     * hart unmasked it, which may have been more than one, so every hart's
+     * context is cleared. A claim taken on an old hart is completed through
+     * the new context once the IRQ is enabled there. */
+    for (cpu = 0; cpu < ksNumCPUs; cpu++) {
+        old_hart_id = cpuIndexToID(cpu);
+        if (plic_hart_irq_enabled(irq, old_hart_id)) {
+            enabled = true;
+            plic_hart_mask_irq(true, irq, old_hart_id);
+        }
+    }
+
+    plic_irq_affinity[irq] = hart_id + 1;
+    if (enabled) {
+        plic_hart_mask_irq(false, irq, hart_id);
+    }
+}
+
+static inline void plic_irq_clear_affinity(irq_t irq)
+{
+    if (plic_irq_affinity[irq] == 0) {
+        return;
+    }
+
+    /* Masking on deletion only cleared the context of the hart that deleted
+     * the handler */
+    plic_hart_mask_irq(true, irq, plic_irq_affinity[irq] - 1);
+    plic_irq_affinity[irq] = 0;
+}
+#endif
+
+#ifdef CONFIG_IRQ_PRIORITIES
+/* Highest priority implemented by the PLIC, probed in plic_init_controller */
+static word_t plic_max_priority_value = 1;
+
+static inline word_t plic_max_priority(void)
+{
+    return plic_max_priority_value;
+}
+
+static inline void plic_irq_set_priority(irq_t irq, word_t priority)
+{
+    writel(priority, PLIC_PPTR_BASE + PLIC_PRIO + PLIC_PRIO_PER_ID * irq);
+}
+#endif
+
 static inline void plic_init_hart(void)
 {
 
@@ -161,7 +247,7 @@ static inline void plic_init_hart(void)
 
     for (int i = 1; i <= PLIC_NUM_INTERRUPTS; i++) {
         /* Disable interrupts */
-        plic_mask_irq(true, i);
+        plic_hart_mask_irq(true, i, hart_id);
     }
 
     /* Set threshold to zero */
@@ -171,6 +257,16 @@ static inline void plic_init_hart(void)
 static inline void plic_init_controller(void)
 {
 
+#ifdef CONFIG_IRQ_PRIORITIES
+    /* The priority registers are WARL, so writing all ones leaves the
+     * highest priority the PLIC implements */
+    writel(0xffffffff, PLIC_PPTR_BASE + PLIC_PRIO + PLIC_PRIO_PER_ID * 1);
+    word_t max_priority = readl(PLIC_PPTR_BASE + PLIC_PRIO + PLIC_PRIO_PER_ID * 1);
+    if (max_priority > 0) {
+        plic_max_priority_value = max_priority;
+    }
+#endif
+
     for (int i = 1; i <= PLIC_NUM_INTERRUPTS; i++) {
         /* Clear all pending bits */
         if (plic_pending_interrupt(i)) {
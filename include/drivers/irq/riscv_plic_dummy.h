@@ -35,6 +35,36 @@ static inline void plic_mask_irq(bool_t disable, irq_t irq)
            disable ? "mask" : "unmask", (int)irq);
 }
 
+#ifdef ENABLE_SMP_SUPPORT
+static inline void plic_irq_set_affinity(irq_t irq, word_t hart_id)
+{
+    printf("no PLIC present, can't route interrupt %d to hart %d\n",
+           (int)irq, (int)hart_id);
+}
+
+static inline void plic_irq_clear_affinity(irq_t irq)
+{
+}
+
+static inline bool_t plic_irq_is_routed(irq_t irq)
+{
+    return false;
+}
+#endif
+
+#ifdef CONFIG_IRQ_PRIORITIES
+static inline word_t plic_max_priority(void)
+{
+    return 1;
+}
+
+static inline void plic_irq_set_priority(irq_t irq, word_t priority)
+{
+    printf("no PLIC present, can't set interrupt %d to priority %d\n",
+           (int)irq, (int)priority);
+}
+#endif
+
 static inline void plic_irq_set_trigger(irq_t irq, bool_t edge_triggered)
 {
     printf("no PLIC present, can't set interrupt %d to %s triggered\n",
@@ -10,6 +10,9 @@
 #include <object/reply.h>
 #include <object/notification.h>
 #endif
+#ifdef CONFIG_CROSSCORE_FASTPATH
+#include <benchmark/benchmark_utilisation.h>
+#endif
 
 #ifdef CONFIG_SIGNAL_FASTPATH
 /* Equivalent to schedContext_donate without migrateTCB() */
@@ -81,15 +84,110 @@ static inline void fastpath_vm_fault_set_mrs(tcb_t *dest)
     setRegister(dest, msgRegisters[0] + seL4_VMFault_FSR,
                 seL4_Fault_VMFault_get_FSR(NODE_STATE(ksCurThread)->tcbFault));
 }
+
+/* Equivalent to copyMRsFault, the parts of the message that don't fit in
+ * registers go to the receiver's IPC buffer if it has one. */
+static inline void fastpath_fault_copy_mrs(tcb_t *dest, word_t *receiveIPCBuffer, MessageID_t id, word_t length)
+{
+    word_t i;
+
+    for (i = 0; i < length && i < n_msgRegisters; i++) {
+        setRegister(dest, msgRegisters[i], getRegister(NODE_STATE(ksCurThread), fault_messages[id][i]));
+    }
+
+    if (receiveIPCBuffer) {
+        for (; i < length; i++) {
+            receiveIPCBuffer[i + 1] = getRegister(NODE_STATE(ksCurThread), fault_messages[id][i]);
+        }
+    }
+}
+
+static inline void fastpath_unknown_syscall_set_mrs(tcb_t *dest)
+{
+    word_t *receiveIPCBuffer = lookupIPCBuffer(true, dest);
+    word_t syscall = seL4_Fault_UnknownSyscall_get_syscallNumber(NODE_STATE(ksCurThread)->tcbFault);
+
+    fastpath_fault_copy_mrs(dest, receiveIPCBuffer, MessageID_Syscall, n_syscallMessage);
+    if (n_syscallMessage < n_msgRegisters) {
+        setRegister(dest, msgRegisters[n_syscallMessage], syscall);
+    } else if (receiveIPCBuffer) {
+        receiveIPCBuffer[n_syscallMessage + 1] = syscall;
+    }
+}
+
+/* The whole user exception message fits in registers, so no IPC buffer is needed */
+compile_assert(user_exception_fits_registers, seL4_UserException_Length <= n_msgRegisters)
+static inline void fastpath_user_exception_set_mrs(tcb_t *dest)
+{
+    fastpath_fault_copy_mrs(dest, NULL, MessageID_Exception, n_exceptionMessage);
+    setRegister(dest, msgRegisters[seL4_UserException_Number],
+                seL4_Fault_UserException_get_number(NODE_STATE(ksCurThread)->tcbFault));
+    setRegister(dest, msgRegisters[seL4_UserException_Code],
+                seL4_Fault_UserException_get_code(NODE_STATE(ksCurThread)->tcbFault));
+}
 #endif
 
-/* Fastpath cap lookup.  Returns a null_cap on failure. */
-static inline cap_t FORCE_INLINE lookup_fp(cap_t cap, cptr_t cptr)
+#ifdef CONFIG_CROSSCORE_FASTPATH
+/* Called once a fastpath has woken a thread on another core. Sends the
+ * reschedule IPIs queued by remoteQueueUpdate now, as a fastpath that returns
+ * to the current thread doesn't go through schedule() */
+static inline void fastpath_remote_reschedule(void)
+{
+    word_t mask = ARCH_NODE_STATE(ipiReschedulePending);
+
+    if (mask) {
+        ARCH_NODE_STATE(ipiReschedulePending) = 0;
+        doMaskReschedule(mask);
+    }
+
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    NODE_STATE(benchmark_crosscore_fastpath)++;
+    NODE_STATE(benchmark_crosscore_fastpath_cycles) += timestamp() - ksEnter;
+#endif
+}
+#endif
+
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+/* Makes the cached slots of every thread stale. A CSpace only changes shape
+ * when a cap is deleted, moved or replaced, or when a thread gets a new CSpace
+ * root. Everything else at most fills an empty slot, such as a cap transfer or
+ * a retype, so lookup_fp rechecks the cap type of a cached slot instead. */
+static inline void fastpath_cap_cache_invalidate(void)
+{
+    ksFastpathCapCacheGeneration++;
+}
+
+/* Fills the entry for cptr in the cache of thread, dropping the entries of an
+ * older generation */
+static inline void fastpath_cap_cache_fill(tcb_t *thread, fastpath_cap_cache_entry_t *entry,
+                                           cptr_t cptr, cte_t *slot)
+{
+    word_t i;
+
+    if (unlikely(thread->tcbCapCacheGeneration != ksFastpathCapCacheGeneration)) {
+        for (i = 0; i < BIT(CONFIG_FASTPATH_CAP_CACHE_BITS); i++) {
+            thread->tcbCapCache[i].slot = NULL;
+        }
+        thread->tcbCapCacheGeneration = ksFastpathCapCacheGeneration;
+    }
+    entry->cptr = cptr;
+    entry->slot = slot;
+}
+#endif
+
+/* Fastpath cap lookup.  Returns a null_cap on failure. count is a constant
+ * at every call site and says whether the lookup is reported in the cache
+ * hit and miss counters. */
+static inline cap_t FORCE_INLINE lookup_fp_common(cap_t cap, cptr_t cptr, bool_t count)
 {
     word_t cptr2;
     cte_t *slot;
     word_t guardBits, radixBits, bits;
     word_t radix, capGuard;
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+    tcb_t *thread = NODE_STATE(ksCurThread);
+    fastpath_cap_cache_entry_t *entry;
+#endif
 
     bits = 0;
 
@@ -97,6 +195,27 @@ static inline cap_t FORCE_INLINE lookup_fp(cap_t cap, cptr_t cptr)
         return cap_null_cap_new();
     }
 
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+    /* Every lookup is done for the current thread from its own CSpace root,
+     * which only changes with a TCB invocation */
+    entry = &thread->tcbCapCache[cptr & MASK(CONFIG_FASTPATH_CAP_CACHE_BITS)];
+    if (likely(thread->tcbCapCacheGeneration == ksFastpathCapCacheGeneration &&
+               entry->cptr == cptr && entry->slot != NULL &&
+               !cap_capType_equals(entry->slot->cap, cap_cnode_cap))) {
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+        if (count) {
+            NODE_STATE(benchmark_cap_cache_hits)++;
+        }
+#endif
+        return entry->slot->cap;
+    }
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    if (count) {
+        NODE_STATE(benchmark_cap_cache_misses)++;
+    }
+#endif
+#endif
+
     do {
         guardBits = cap_cnode_cap_get_capCNodeGuardSize(cap);
         radixBits = cap_cnode_cap_get_capCNodeRadix(cap);
@@ -126,8 +245,38 @@ static inline cap_t FORCE_INLINE lookup_fp(cap_t cap, cptr_t cptr)
         return cap_null_cap_new();
     }
 
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+    fastpath_cap_cache_fill(thread, entry, cptr, slot);
+#endif
+
     return cap;
 }
+
+static inline cap_t FORCE_INLINE lookup_fp(cap_t cap, cptr_t cptr)
+{
+    return lookup_fp_common(cap, cptr, true);
+}
+
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+/* For the Call entry, which looks the cptr up once in C before fastpath_call
+ * looks it up again. Only the second lookup is counted. */
+static inline cap_t FORCE_INLINE lookup_fp_uncounted(cap_t cap, cptr_t cptr)
+{
+    return lookup_fp_common(cap, cptr, false);
+}
+
+/* Only invocations of a CNode or a TCB delete, move or replace caps or change
+ * a CSpace root, so the cache is kept across all others. cap is the result of
+ * a lookup of the invoked cptr by the fastpath or the batch. */
+static inline void fastpath_cap_cache_check_invocation(cap_t cap)
+{
+    if (unlikely(cap_capType_equals(cap, cap_cnode_cap) ||
+                 cap_capType_equals(cap, cap_thread_cap))) {
+        fastpath_cap_cache_invalidate();
+    }
+}
+#endif
+
 void thread_state_ptr_set_tsType_np(thread_state_t *ts_ptr, word_t tsType);
 /* make sure the fastpath functions conform with structure_*.bf */
 // static inline void thread_state_ptr_set_tsType_np(thread_state_t *ts_ptr, word_t tsType)
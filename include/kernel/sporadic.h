@@ -61,6 +61,13 @@ static inline refill_t *refill_tail(sched_context_t *sc)
 {
     return refill_index(sc, sc->scRefillTail);
 }
+#ifdef CONFIG_RELEASE_SLACK
+/* The slack is the amount of the refill slot right after the circular buffer */
+static inline ticks_t *sc_slack(sched_context_t *sc)
+{
+    return &refill_index(sc, sc->scRefillMax)->rAmount;
+}
+#endif
 
 
 /* Scheduling context objects consist of a sched_context_t at the start, followed by a
@@ -10,6 +10,10 @@
 #include <util.h>
 #include <arch/kernel/traps.h>
 #include <smp/lock.h>
+#ifdef CONFIG_WAKEUP_INBOX
+#include <model/statedata.h>
+#include <object/tcb.h>
+#endif
 
 /* This C function should be the first thing called from C after entry from
  * assembly. It provides a single place to do any entry work that is not
@@ -20,6 +24,15 @@ static inline void c_entry_hook(void)
 #if defined(CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES) || defined(CONFIG_BENCHMARK_TRACK_UTILISATION)
     ksEnter = timestamp();
 #endif
+#ifdef CONFIG_WAKEUP_INBOX
+    /* Takes in the threads other cores woke here since the last entry.
+     * Entries under the shared lock or no lock leave the inbox to the next
+     * one that takes big_kernel_lock. */
+    if (clh_is_self_in_queue() &&
+        unlikely(__atomic_load_n(&NODE_STATE(ksWakeupInbox), __ATOMIC_RELAXED) != NULL)) {
+        wakeupInboxSplice();
+    }
+#endif
 }
 
 /* This C function should be the last thing called from C before exiting
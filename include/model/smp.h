@@ -23,5 +23,10 @@ extern smpStatedata_t ksSMP[CONFIG_MAX_NUM_NODES];
 
 void migrateTCB(tcb_t *tcb, word_t new_core);
 
+#ifdef CONFIG_WORK_STEALING
+void stealWork(void);
+void stealKick(void);
+#endif
+
 #endif /* ENABLE_SMP_SUPPORT */
 
@@ -55,6 +55,16 @@
 #define NUM_READY_QUEUES (CONFIG_NUM_DOMAINS * CONFIG_NUM_PRIORITIES)
 #define L2_BITMAP_SIZE ((CONFIG_NUM_PRIORITIES + wordBits - 1) / wordBits)
 
+#ifdef CONFIG_ASYNC_EXECUTOR
+/* Executors with a submitted ring, in the order they are run. Head and tail
+ * are free running. */
+typedef struct executor_queue {
+    tcb_t *executors[CONFIG_ASYNC_EXECUTOR_QUEUE_LENGTH];
+    word_t head;
+    word_t tail;
+} executor_queue_t;
+#endif
+
 NODE_STATE_BEGIN(nodeState)
 NODE_STATE_DECLARE(tcb_queue_t, ksReadyQueues[NUM_READY_QUEUES]);
 NODE_STATE_DECLARE(word_t, ksReadyQueuesL1Bitmap[CONFIG_NUM_DOMAINS]);
@@ -65,6 +75,9 @@ NODE_STATE_DECLARE(tcb_t, *ksSchedulerAction);
 
 #ifdef CONFIG_KERNEL_MCS
 NODE_STATE_DECLARE(tcb_t, *ksReleaseHead);
+#ifdef CONFIG_RELEASE_HEAP
+NODE_STATE_DECLARE(word_t, ksReleaseHeapSize);
+#endif
 NODE_STATE_DECLARE(time_t, ksConsumed);
 NODE_STATE_DECLARE(time_t, ksCurTime);
 NODE_STATE_DECLARE(bool_t, ksReprogram);
@@ -78,6 +91,21 @@ NODE_STATE_DECLARE(user_fpu_state_t *, ksActiveFPUState);
 /* Number of times we have restored a user context with an active FPU without switching it */
 NODE_STATE_DECLARE(word_t, ksFPURestoresSinceSwitch);
 #endif /* CONFIG_HAVE_FPU */
+#ifdef CONFIG_RISCV_EXT_V
+/* Thread whose state is in the vector registers, or NULL */
+NODE_STATE_DECLARE(tcb_t, *ksActiveVectorOwner);
+#endif
+#ifdef CONFIG_ASYNC_EXECUTOR
+NODE_STATE_DECLARE(executor_queue_t, ksExecutorQueue);
+#endif
+#ifdef CONFIG_WORK_STEALING
+/* Whether a busy core has kicked this idle core to steal, and it hasn't yet */
+NODE_STATE_DECLARE(bool_t, ksStealPending);
+#endif
+#ifdef CONFIG_WAKEUP_INBOX
+/* Threads other cores have woken on this core, most recent first */
+NODE_STATE_DECLARE(tcb_t *, ksWakeupInbox);
+#endif
 #ifdef CONFIG_DEBUG_BUILD
 NODE_STATE_DECLARE(tcb_t *, ksDebugTCBs);
 #endif /* CONFIG_DEBUG_BUILD */
@@ -88,6 +116,52 @@ NODE_STATE_DECLARE(timestamp_t, benchmark_end_time);
 NODE_STATE_DECLARE(timestamp_t, benchmark_kernel_time);
 NODE_STATE_DECLARE(timestamp_t, benchmark_kernel_number_entries);
 NODE_STATE_DECLARE(timestamp_t, benchmark_kernel_number_schedules);
+#ifdef CONFIG_CROSSCORE_FASTPATH
+NODE_STATE_DECLARE(uint64_t, benchmark_crosscore_fastpath);
+NODE_STATE_DECLARE(uint64_t, benchmark_crosscore_fastpath_cycles);
+#endif
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+NODE_STATE_DECLARE(uint64_t, benchmark_cap_cache_hits);
+NODE_STATE_DECLARE(uint64_t, benchmark_cap_cache_misses);
+#endif
+#ifdef CONFIG_BATCH_INVOCATION
+NODE_STATE_DECLARE(uint64_t, benchmark_batch_invocations);
+NODE_STATE_DECLARE(uint64_t, benchmark_batch_cycles);
+#endif
+#ifdef CONFIG_ASYNC_EXECUTOR
+NODE_STATE_DECLARE(uint64_t, benchmark_async_invocations);
+NODE_STATE_DECLARE(uint64_t, benchmark_async_completions);
+NODE_STATE_DECLARE(uint64_t, benchmark_async_cycles);
+#endif
+#ifdef CONFIG_RELEASE_SLACK
+NODE_STATE_DECLARE(uint64_t, benchmark_coalesced_releases);
+#endif
+#ifdef CONFIG_WORK_STEALING
+NODE_STATE_DECLARE(uint64_t, benchmark_steals);
+NODE_STATE_DECLARE(uint64_t, benchmark_migrations);
+#endif
+#ifdef CONFIG_WAKEUP_INBOX
+NODE_STATE_DECLARE(uint64_t, benchmark_inbox_wakeups);
+#endif
+#ifdef CONFIG_TARGETED_REMOTE_CALLS
+NODE_STATE_DECLARE(uint64_t, benchmark_remote_calls);
+#endif
+#ifdef CONFIG_ARCH_RISCV
+NODE_STATE_DECLARE(uint64_t, benchmark_timer_programs);
+NODE_STATE_DECLARE(uint64_t, benchmark_timer_program_cycles);
+NODE_STATE_DECLARE(uint64_t, benchmark_ipi_sends);
+NODE_STATE_DECLARE(uint64_t, benchmark_ipi_send_cycles);
+NODE_STATE_DECLARE(uint64_t, benchmark_timer_irqs);
+NODE_STATE_DECLARE(uint64_t, benchmark_timer_irq_cycles);
+NODE_STATE_DECLARE(uint64_t, benchmark_trap_entries);
+NODE_STATE_DECLARE(uint64_t, benchmark_trap_entry_cycles);
+NODE_STATE_DECLARE(uint64_t, benchmark_ipc_trap_entries);
+NODE_STATE_DECLARE(uint64_t, benchmark_ipc_trap_entry_cycles);
+#endif
+#ifdef CONFIG_RISCV_IRQ_BATCH
+NODE_STATE_DECLARE(uint64_t, benchmark_irq_batch_entries);
+NODE_STATE_DECLARE(uint64_t, benchmark_irq_batch_irqs);
+#endif
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
 
 NODE_STATE_END(nodeState);
@@ -114,6 +188,10 @@ extern word_t ksDomainTime;
 #endif
 extern word_t tlbLockCount VISIBLE;
 
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+extern word_t ksFastpathCapCacheGeneration VISIBLE;
+#endif
+
 extern char ksIdleThreadTCB[CONFIG_MAX_NUM_NODES][BIT(seL4_TCBBits)];
 
 #ifdef CONFIG_KERNEL_MCS
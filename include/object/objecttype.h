@@ -55,6 +55,9 @@ void postCapDeletion(cap_t* cap)
     if (cap_get_capType(*cap) == cap_irq_handler_cap) {
         irq_t irq = IDX_TO_IRQT(cap_irq_handler_cap_get_capIRQ(*cap));
         deletedIRQHandler(irq);
+#ifdef CONFIG_IRQ_AFFINITY
+        clearIRQAffinity(irq);
+#endif
     } else if (isArchCap(*cap)) {
         Arch_postCapDeletion(*cap);
     }
@@ -247,6 +247,14 @@ typedef struct sched_context sched_context_t;
 typedef struct reply reply_t;
 #endif
 
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+/* A slot found by a fastpath cap lookup of a thread, 2 words */
+typedef struct fastpath_cap_cache_entry {
+    cptr_t cptr;
+    struct cte *slot;
+} fastpath_cap_cache_entry_t;
+#endif
+
 /* TCB: size >= 18 words + sizeof(arch_tcb_t) + 1 word on MCS (aligned to nearest power of 2) */
 struct tcb {
     /* arch specific tcb state (including context)*/
@@ -298,7 +306,9 @@ struct tcb {
     word_t tcbAffinity;
 #endif /* ENABLE_SMP_SUPPORT */
 
-    /* Previous and next pointers for scheduler queues , 2 words */
+    /* Previous and next pointers for scheduler queues , 2 words
+     * With CONFIG_RELEASE_HEAP they are the left and right child in the
+     * release heap while the thread is in it */
     struct tcb *tcbSchedNext;
     struct tcb *tcbSchedPrev;
     /* Preivous and next pointers for endpoint and notification queues, 2 words */
@@ -309,6 +319,40 @@ struct tcb {
     /* 16 bytes (12 bytes aarch32) */
     benchmark_util_t benchmark;
 #endif
+
+#ifdef CONFIG_RELEASE_HEAP
+    /* Parent in the release heap, 1 word */
+    struct tcb *tcbReleaseParent;
+#endif
+
+#ifdef CONFIG_WORK_STEALING
+    /* Whether an idle core may pull this thread from the ready queue of its
+     * core, 1 word */
+    word_t tcbMigratable;
+#endif
+
+#ifdef CONFIG_WAKEUP_INBOX
+    /* Next thread in the wakeup inbox the thread is in, and how it is to be
+     * queued once the inbox is spliced, or 0 if it isn't in one, 2 words */
+    struct tcb *tcbWakeupNext;
+    word_t tcbWakeupMode;
+#endif
+
+#ifdef CONFIG_RISCV_EXT_V
+    /* Kernel slot holding a copy of the cap to the frame with the thread's
+     * vector state, or NULL if the thread doesn't use the vector extension,
+     * 1 word */
+    struct cte *tcbVectorState;
+#endif
+
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+    /* Slots found by the fastpath cap lookups of the thread, indexed by the
+     * low bits of the cptr and valid while tcbCapCacheGeneration is
+     * ksFastpathCapCacheGeneration, 1 + 2 * BIT(CONFIG_FASTPATH_CAP_CACHE_BITS)
+     * words */
+    word_t tcbCapCacheGeneration;
+    fastpath_cap_cache_entry_t tcbCapCache[BIT(CONFIG_FASTPATH_CAP_CACHE_BITS)];
+#endif
 };
 typedef struct tcb tcb_t;
 
@@ -339,6 +383,12 @@ typedef struct refill {
 } refill_t;
 
 #define MIN_REFILLS 2u
+#ifdef CONFIG_RELEASE_SLACK
+/* the refill slot after the last one in use holds the slack */
+#define SLACK_REFILLS 1u
+#else
+#define SLACK_REFILLS 0u
+#endif
 
 struct sched_context {
     /* period for this sc -- controls rate at which budget is replenished */
@@ -416,8 +466,12 @@ compile_assert(ep_size_sane, sizeof(endpoint_t) == BIT(seL4_EndpointBits))
 /* Check the IPC buffer is the right size */
 compile_assert(ipc_buf_size_sane, sizeof(seL4_IPCBuffer) == BIT(seL4_IPCBufferSizeBits))
 #ifdef CONFIG_KERNEL_MCS
-compile_assert(sc_core_size_sane, (sizeof(sched_context_t) + MIN_REFILLS *sizeof(refill_t) ==
+compile_assert(sc_core_size_sane, (sizeof(sched_context_t) + (MIN_REFILLS + SLACK_REFILLS) *sizeof(refill_t) ==
                                    seL4_CoreSchedContextBytes))
+/* The Rust part of the kernel places the refills right after ten words and two
+ * ticks_t, with the same layout for any configuration */
+compile_assert(sc_core_layout_shared, sizeof(sched_context_t) ==
+               10 * sizeof(word_t) + 2 * sizeof(ticks_t))
 compile_assert(reply_size_sane, sizeof(reply_t) == BIT(seL4_ReplyBits))
 compile_assert(refill_size_sane, (sizeof(refill_t) == seL4_RefillSizeBytes))
 #endif
@@ -62,12 +62,29 @@ void tcbDebugRemove(tcb_t *tcb);
 void tcbReleaseRemove(tcb_t *tcb);
 void tcbReleaseEnqueue(tcb_t *tcb);
 tcb_t *tcbReleaseDequeue(void);
+#ifdef CONFIG_RELEASE_SLACK
+ticks_t tcbReleaseDeadline(void);
+#endif
 #endif
 
 #ifdef ENABLE_SMP_SUPPORT
 void remoteQueueUpdate(tcb_t *tcb);
 void remoteTCBStall(tcb_t *tcb);
 
+#ifdef CONFIG_WAKEUP_INBOX
+enum wakeup_mode {
+    WakeupMode_Enqueue = 1,
+    WakeupMode_Append = 2
+};
+typedef word_t wakeup_mode_t;
+
+void wakeupQueue(tcb_t *tcb, wakeup_mode_t mode);
+void wakeupInboxSplice(void);
+void wakeupInboxRemove(tcb_t *tcb);
+
+#define SCHED_ENQUEUE(_t) wakeupQueue(_t, WakeupMode_Enqueue)
+#define SCHED_APPEND(_t) wakeupQueue(_t, WakeupMode_Append)
+#else
 #define SCHED_ENQUEUE(_t)      \
     do                         \
     {                          \
@@ -81,6 +98,7 @@ void remoteTCBStall(tcb_t *tcb);
         tcbSchedAppend(_t);    \
         remoteQueueUpdate(_t); \
     } while (0)
+#endif /* CONFIG_WAKEUP_INBOX */
 
 #else
 #define SCHED_ENQUEUE(_t) tcbSchedEnqueue(_t)
@@ -168,6 +186,9 @@ exception_t decodeUnbindNotification(cap_t *cap);
 #ifdef CONFIG_KERNEL_MCS
 exception_t decodeSetTimeoutEndpoint(cap_t cap, cte_t *slot);
 #endif
+#ifdef CONFIG_WORK_STEALING
+exception_t decodeSetMigratable(cap_t cap, word_t length, word_t *buffer);
+#endif
 
 #ifdef CONFIG_KERNEL_MCS
 enum thread_control_caps_flag
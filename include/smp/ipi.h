@@ -30,6 +30,42 @@ static inline word_t get_ipi_arg(word_t n)
     return ipi_args[n];
 }
 
+#ifdef CONFIG_TARGETED_REMOTE_CALLS
+typedef struct remote_call {
+    IpiRemoteCall_t func;
+    word_t args[MAX_IPI_ARGS];
+} remote_call_t;
+
+/* The caller of a remote call holds the lock and waits for the call, so a core
+ * never has more than one call queued */
+#define REMOTE_CALL_QUEUE_LENGTH 1
+
+/* Remote calls queued for a core. Callers hold the lock and add calls at the
+ * tail, the core takes them from the head without it, so a call is complete
+ * once head has passed it. */
+typedef struct remote_call_queue {
+    remote_call_t calls[REMOTE_CALL_QUEUE_LENGTH];
+    word_t head;
+    word_t tail;
+} ALIGN(L1_CACHE_LINE_SIZE) remote_call_queue_t;
+
+static remote_call_queue_t remoteCallQueue[CONFIG_MAX_NUM_NODES];
+
+static inline bool_t remote_calls_pending(word_t cpu)
+{
+    return __atomic_load_n(&remoteCallQueue[cpu].tail, __ATOMIC_ACQUIRE) != remoteCallQueue[cpu].head;
+}
+
+/* Called by the target once it is done with the call at the head */
+static inline void remote_call_complete(word_t cpu)
+{
+    __atomic_store_n(&remoteCallQueue[cpu].head, remoteCallQueue[cpu].head + 1, __ATOMIC_RELEASE);
+}
+
+/* Runs the remote calls queued for the current core */
+void handleRemoteCalls(bool_t irqPath);
+#endif
+
 static inline void ipi_wait(word_t cores)
 {
     word_t localsense = ipiSyncBarrier.globalsense;
@@ -13,6 +13,14 @@
 #include <arch/model/statedata.h>
 #include <smp/ipi.h>
 #include <util.h>
+#ifdef CONFIG_FINE_GRAINED_LOCKING
+#include <assert.h>
+#include <sel4/sel4_arch/constants.h>
+#endif
+#ifdef CONFIG_BENCHMARK_GENERIC
+#include <arch/benchmark.h>
+#include <sel4/benchmark_lock_types.h>
+#endif
 
 #ifdef ENABLE_SMP_SUPPORT
 
@@ -52,6 +60,73 @@ typedef struct clh_lock {
 extern clh_lock_t big_kernel_lock;
 BOOT_CODE void clh_lock_init(void);
 
+#ifdef CONFIG_BENCHMARK_GENERIC
+/* Written by each core for itself only */
+typedef struct benchmark_lock_stats {
+    uint64_t values[BENCHMARK_LOCK_NUM_VALUES];
+
+    PAD_TO_NEXT_CACHE_LN(sizeof(uint64_t) * BENCHMARK_LOCK_NUM_VALUES);
+} benchmark_lock_stats_t;
+
+extern benchmark_lock_stats_t ksLockStats[CONFIG_MAX_NUM_NODES];
+#endif
+
+#ifdef CONFIG_FINE_GRAINED_LOCKING
+/* Lock order, outermost first:
+ *
+ * 1. big_kernel_lock. Taking it waits for every other core to leave the shared
+ *    lock, so its holder excludes all of the below and may touch any state.
+ * 2. The shared lock of the current core, held instead of big_kernel_lock by
+ *    the send and wait fastpaths. Its holder only touches the ready queues of
+ *    its own core, its current thread, and the objects it has locked, so the
+ *    ready queues need no lock of their own: other cores only change them
+ *    while holding big_kernel_lock.
+ * 3. One object lock, for the endpoint or notification the fastpath uses,
+ *    taken before its state is read. Threads queued on an endpoint are
+ *    covered by its lock. A fastpath never holds two object locks. One that
+ *    needed to would have to take them in increasing index order.
+ *
+ * A fastpath that falls back to the slowpath drops its object lock and trades
+ * the shared lock for big_kernel_lock before changing any state. Object locks
+ * are never held while waiting for big_kernel_lock. */
+typedef struct shared_lock_node {
+    word_t held;
+    /* index + 1 of the object lock held by this core, or 0 */
+    word_t object;
+
+    PAD_TO_NEXT_CACHE_LN(2 * sizeof(word_t));
+} shared_lock_node_t;
+
+/* Ticket lock, for fairness between cores on a hot endpoint */
+typedef struct object_lock {
+    word_t next;
+    word_t owner;
+
+    PAD_TO_NEXT_CACHE_LN(2 * sizeof(word_t));
+} object_lock_t;
+
+typedef struct fine_grained_lock {
+    shared_lock_node_t shared[CONFIG_MAX_NUM_NODES];
+    object_lock_t objects[BIT(CONFIG_OBJECT_LOCK_BITS)];
+    /* number of cores holding or waiting for big_kernel_lock */
+    word_t exclusive;
+
+    PAD_TO_NEXT_CACHE_LN(sizeof(word_t));
+} fine_grained_lock_t;
+
+extern fine_grained_lock_t fine_grained_lock;
+
+/* Called with big_kernel_lock held, waits for the shared holders to leave */
+static inline void shared_lock_drain(word_t cpu)
+{
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        while (i != cpu && __atomic_load_n(&fine_grained_lock.shared[i].held, __ATOMIC_ACQUIRE)) {
+            arch_pause();
+        }
+    }
+}
+#endif /* CONFIG_FINE_GRAINED_LOCKING */
+
 static inline bool_t FORCE_INLINE clh_is_ipi_pending(word_t cpu)
 {
     return big_kernel_lock.node_owners[cpu].ipi == 1;
@@ -95,6 +170,13 @@ void clh_lock_acquire(word_t cpu, bool_t irqPath);
 void clh_lock_acquire(word_t cpu, bool_t irqPath)
 {
     clh_qnode_t *prev;
+#ifdef CONFIG_BENCHMARK_GENERIC
+    timestamp_t start = timestamp();
+#endif
+#ifdef CONFIG_FINE_GRAINED_LOCKING
+    /* stop new shared holders before queueing */
+    __atomic_fetch_add(&fine_grained_lock.exclusive, 1, __ATOMIC_SEQ_CST);
+#endif
     big_kernel_lock.node_owners[cpu].node->value = CLHState_Pending;
 
     prev = sel4_atomic_exchange(&big_kernel_lock.head, irqPath, cpu, __ATOMIC_ACQ_REL);
@@ -118,8 +200,17 @@ void clh_lock_acquire(word_t cpu, bool_t irqPath)
         arch_pause();
     }
 
+#ifdef CONFIG_FINE_GRAINED_LOCKING
+    shared_lock_drain(cpu);
+#endif
+
     /* make sure no resource access passes from this point */
     __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+#ifdef CONFIG_BENCHMARK_GENERIC
+    ksLockStats[cpu].values[BENCHMARK_LOCK_ACQUISITIONS]++;
+    ksLockStats[cpu].values[BENCHMARK_LOCK_WAIT_CYCLES] += timestamp() - start;
+#endif
 }
 
 void clh_lock_release(word_t cpu);
@@ -132,6 +223,11 @@ void clh_lock_release(word_t cpu)
     big_kernel_lock.node_owners[cpu].node->value = CLHState_Granted;
     big_kernel_lock.node_owners[cpu].node =
         big_kernel_lock.node_owners[cpu].next;
+#ifdef CONFIG_FINE_GRAINED_LOCKING
+    /* after handing over the lock, so the count never drops to 0 between
+     * two holders */
+    __atomic_fetch_sub(&fine_grained_lock.exclusive, 1, __ATOMIC_RELEASE);
+#endif
 }
 
 bool_t clh_is_self_in_queue(void);
@@ -161,6 +257,77 @@ bool_t clh_is_self_in_queue(void)
     }                                                    \
 } while(0)
 
+#ifdef CONFIG_FINE_GRAINED_LOCKING
+/* Takes the shared lock of the current core, or big_kernel_lock if another
+ * core holds or waits for it */
+static inline void shared_lock_acquire(void)
+{
+    word_t cpu = getCurrentCPUIndex();
+
+    __atomic_store_n(&fine_grained_lock.shared[cpu].held, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (unlikely(__atomic_load_n(&fine_grained_lock.exclusive, __ATOMIC_ACQUIRE) != 0)) {
+        __atomic_store_n(&fine_grained_lock.shared[cpu].held, 0, __ATOMIC_RELEASE);
+        clh_lock_acquire(cpu, false);
+    }
+}
+
+static inline bool_t shared_lock_is_held(void)
+{
+    return fine_grained_lock.shared[getCurrentCPUIndex()].held != 0;
+}
+
+static inline word_t CONST object_lock_index(void *object)
+{
+    word_t addr = (word_t)object >> seL4_EndpointBits;
+
+    return (addr ^ (addr >> CONFIG_OBJECT_LOCK_BITS)) & MASK(CONFIG_OBJECT_LOCK_BITS);
+}
+
+static inline void object_lock_acquire(void *object)
+{
+    word_t index = object_lock_index(object);
+    object_lock_t *lock = &fine_grained_lock.objects[index];
+    word_t ticket = __atomic_fetch_add(&lock->next, 1, __ATOMIC_RELAXED);
+
+    assert(fine_grained_lock.shared[getCurrentCPUIndex()].object == 0);
+    while (__atomic_load_n(&lock->owner, __ATOMIC_ACQUIRE) != ticket) {
+        arch_pause();
+    }
+    fine_grained_lock.shared[getCurrentCPUIndex()].object = index + 1;
+}
+
+/* Drops the object lock and the shared lock, if held. big_kernel_lock is left
+ * to NODE_UNLOCK_IF_HELD. */
+static inline void shared_lock_release(void)
+{
+    shared_lock_node_t *node = &fine_grained_lock.shared[getCurrentCPUIndex()];
+
+    if (node->object != 0) {
+        object_lock_t *lock = &fine_grained_lock.objects[node->object - 1];
+        node->object = 0;
+        __atomic_store_n(&lock->owner, lock->owner + 1, __ATOMIC_RELEASE);
+    }
+    if (node->held) {
+        __atomic_store_n(&node->held, 0, __ATOMIC_RELEASE);
+    }
+}
+
+/* Makes sure big_kernel_lock is held, before going to the slowpath */
+static inline void shared_lock_upgrade(void)
+{
+    bool_t shared = shared_lock_is_held();
+
+    shared_lock_release();
+    if (shared) {
+#ifdef CONFIG_BENCHMARK_GENERIC
+        ksLockStats[getCurrentCPUIndex()].values[BENCHMARK_LOCK_UPGRADES]++;
+#endif
+        clh_lock_acquire(getCurrentCPUIndex(), false);
+    }
+}
+#endif /* CONFIG_FINE_GRAINED_LOCKING */
+
 #else
 #define NODE_LOCK(_irq) do {} while (0)
 #define NODE_UNLOCK do {} while (0)
@@ -169,6 +336,12 @@ bool_t clh_is_self_in_queue(void)
 #endif /* ENABLE_SMP_SUPPORT */
 
 #define NODE_LOCK_SYS NODE_LOCK(false)
+#ifdef CONFIG_FINE_GRAINED_LOCKING
+/* For the fastpaths that can run under the shared lock */
+#define NODE_LOCK_SHARED shared_lock_acquire()
+#else
+#define NODE_LOCK_SHARED NODE_LOCK_SYS
+#endif
 #define NODE_LOCK_IRQ NODE_LOCK(true)
 #define NODE_LOCK_SYS_IF(_cond) NODE_LOCK_IF(_cond, false)
 #define NODE_LOCK_IRQ_IF(_cond) NODE_LOCK_IF(_cond, true)
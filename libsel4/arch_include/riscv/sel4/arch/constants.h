@@ -6,3 +6,18 @@
 
 #pragma once
 
+
+#include <autoconf.h>
+
+/* Number of message registers passed in registers by seL4_Send and
+ * seL4_NBSend. MR0-MR3 are in a2-a5 and any further ones in t1-t6. Every
+ * other syscall passes MR0-MR3 in registers and the rest in the IPC buffer. */
+#ifdef CONFIG_RISCV_FAST_MESSAGE_REGISTERS
+#define seL4_FastMessageRegisters CONFIG_RISCV_FAST_MESSAGE_REGISTERS
+#else
+#define seL4_FastMessageRegisters 4
+#endif
+
+#if seL4_FastMessageRegisters < 4 || seL4_FastMessageRegisters > 10
+#error "seL4_FastMessageRegisters must be between 4 and 10"
+#endif
@@ -22,9 +22,45 @@
 #define LIBSEL4_MCS_REPLY 0
 #endif
 
+#ifdef CONFIG_RISCV_SYSCALL_PARTIAL_SAVE
+/* The kernel does not preserve the temporaries across seL4_Call and
+ * seL4_ReplyRecv */
+#define SEND_RECV_CLOBBERS "memory", "t0", "t1", "t2", "t3", "t4", "t5", "t6"
+#else
+#define SEND_RECV_CLOBBERS "memory"
+#endif
+
+#if seL4_FastMessageRegisters > 4
+/* Message registers past MR3 are taken from the IPC buffer and passed in
+ * t1-t6, see seL4_FastMessageRegisters. Only the ones inside the message are
+ * read, so short messages and threads without an IPC buffer don't touch it.
+ * They are read into plain locals first, as the compiler only keeps a
+ * register variable in its register at the asm statement and the reads could
+ * otherwise reuse t1-t6. */
+#define RISCV_FAST_MR_LOAD(n) \
+    seL4_Word mr##n = seL4_FastMessageRegisters > n && n < length ? seL4_GetMR(n) : 0
+#define FAST_MR_LOAD \
+    RISCV_FAST_MR_LOAD(4); RISCV_FAST_MR_LOAD(5); RISCV_FAST_MR_LOAD(6); \
+    RISCV_FAST_MR_LOAD(7); RISCV_FAST_MR_LOAD(8); RISCV_FAST_MR_LOAD(9)
+#define RISCV_FAST_MR(n, r) register seL4_Word msg##n asm(r) = mr##n
+#define FAST_MR_DECL \
+    RISCV_FAST_MR(4, "t1"); RISCV_FAST_MR(5, "t2"); RISCV_FAST_MR(6, "t3"); \
+    RISCV_FAST_MR(7, "t4"); RISCV_FAST_MR(8, "t5"); RISCV_FAST_MR(9, "t6")
+#define FAST_MR_PARAM , "r"(msg4), "r"(msg5), "r"(msg6), "r"(msg7), "r"(msg8), "r"(msg9)
+#else
+#define FAST_MR_LOAD
+#define FAST_MR_DECL
+#define FAST_MR_PARAM
+#endif
+
+/* length is the message length, message registers from MR4 up to it are read
+ * from the IPC buffer. 0 means the IPC buffer is never read. */
 static inline void riscv_sys_send(seL4_Word sys, seL4_Word dest, seL4_Word info_arg, seL4_Word mr0, seL4_Word mr1,
-                                  seL4_Word mr2, seL4_Word mr3)
+                                  seL4_Word mr2, seL4_Word mr3, LIBSEL4_UNUSED seL4_Word length)
 {
+    /* Read before any register variable is live, seL4_GetMR may be a call */
+    FAST_MR_LOAD;
+
     register seL4_Word destptr asm("a0") = dest;
     register seL4_Word info asm("a1") = info_arg;
 
@@ -36,11 +72,12 @@ static inline void riscv_sys_send(seL4_Word sys, seL4_Word dest, seL4_Word info_
 
     /* Perform the system call. */
     register seL4_Word scno asm("a7") = sys;
+    FAST_MR_DECL;
     asm volatile(
         "ecall"
         : "+r"(destptr), "+r"(msg0), "+r"(msg1), "+r"(msg2),
         "+r"(msg3), "+r"(info)
-        : "r"(scno)
+        : "r"(scno) FAST_MR_PARAM
     );
 }
 
@@ -144,7 +181,7 @@ static inline void riscv_sys_send_recv(seL4_Word sys, seL4_Word dest, seL4_Word
         : "+r"(msg0), "+r"(msg1), "+r"(msg2), "+r"(msg3),
         "+r"(info), "+r"(destptr)
         : "r"(scno) MCS_PARAM
-        : "memory"
+        : SEND_RECV_CLOBBERS
     );
     *out_info = info;
     *out_badge = destptr;
@@ -194,37 +231,41 @@ static inline void riscv_sys_nbsend_recv(seL4_Word sys, seL4_Word dest, seL4_Wor
 LIBSEL4_INLINE_FUNC void seL4_Send(seL4_CPtr dest, seL4_MessageInfo_t msgInfo)
 {
     riscv_sys_send(seL4_SysSend, dest, msgInfo.words[0], seL4_GetMR(0), seL4_GetMR(1),
-                   seL4_GetMR(2), seL4_GetMR(3));
+                   seL4_GetMR(2), seL4_GetMR(3), seL4_MessageInfo_get_length(msgInfo));
 }
 
 LIBSEL4_INLINE_FUNC void seL4_SendWithMRs(seL4_CPtr dest, seL4_MessageInfo_t msgInfo,
                                           seL4_Word *mr0, seL4_Word *mr1, seL4_Word *mr2, seL4_Word *mr3)
 {
+    /* As without seL4_FastMessageRegisters, MR4 and up come from the IPC
+     * buffer, which only a message longer than four has to have */
     riscv_sys_send(seL4_SysSend, dest, msgInfo.words[0],
                    mr0 != seL4_Null && seL4_MessageInfo_get_length(msgInfo) > 0 ? *mr0 : 0,
                    mr1 != seL4_Null && seL4_MessageInfo_get_length(msgInfo) > 0 ? *mr1 : 0,
                    mr2 != seL4_Null && seL4_MessageInfo_get_length(msgInfo) > 0 ? *mr2 : 0,
-                   mr3 != seL4_Null && seL4_MessageInfo_get_length(msgInfo) > 0 ? *mr3 : 0
-                  );
+                   mr3 != seL4_Null && seL4_MessageInfo_get_length(msgInfo) > 0 ? *mr3 : 0,
+                   seL4_MessageInfo_get_length(msgInfo));
 
 }
 
 LIBSEL4_INLINE_FUNC void seL4_NBSend(seL4_CPtr dest, seL4_MessageInfo_t msgInfo)
 {
     riscv_sys_send(seL4_SysNBSend, dest, msgInfo.words[0], seL4_GetMR(0), seL4_GetMR(1),
-                   seL4_GetMR(2), seL4_GetMR(3));
+                   seL4_GetMR(2), seL4_GetMR(3), seL4_MessageInfo_get_length(msgInfo));
 
 }
 
 LIBSEL4_INLINE_FUNC void seL4_NBSendWithMRs(seL4_CPtr dest, seL4_MessageInfo_t msgInfo,
                                             seL4_Word *mr0, seL4_Word *mr1, seL4_Word *mr2, seL4_Word *mr3)
 {
+    /* As without seL4_FastMessageRegisters, MR4 and up come from the IPC
+     * buffer, which only a message longer than four has to have */
     riscv_sys_send(seL4_SysNBSend, dest, msgInfo.words[0],
                    mr0 != seL4_Null && seL4_MessageInfo_get_length(msgInfo) > 0 ? *mr0 : 0,
                    mr1 != seL4_Null && seL4_MessageInfo_get_length(msgInfo) > 0 ? *mr1 : 0,
                    mr2 != seL4_Null && seL4_MessageInfo_get_length(msgInfo) > 0 ? *mr2 : 0,
-                   mr3 != seL4_Null && seL4_MessageInfo_get_length(msgInfo) > 0 ? *mr3 : 0
-                  );
+                   mr3 != seL4_Null && seL4_MessageInfo_get_length(msgInfo) > 0 ? *mr3 : 0,
+                   seL4_MessageInfo_get_length(msgInfo));
 
 }
 
@@ -1001,3 +1042,48 @@ LIBSEL4_INLINE_FUNC void seL4_SetTLSBase(seL4_Word tls_base)
     asm volatile("" ::: "memory");
 }
 #endif /* CONFIG_SET_TLS_BASE_SELF */
+
+#ifdef CONFIG_BATCH_INVOCATION
+LIBSEL4_INLINE_FUNC seL4_Error seL4_BatchInvoke(seL4_CPtr ring)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    seL4_Word unused2 = 0;
+    seL4_Word unused3 = 0;
+    seL4_Word unused4 = 0;
+
+    riscv_sys_send_recv(seL4_SysBatchInvoke, ring, &ring, 0, &unused0, &unused1, &unused2,
+                        &unused3, &unused4, 0);
+    return (seL4_Error)ring;
+}
+#endif /* CONFIG_BATCH_INVOCATION */
+
+#ifdef CONFIG_ASYNC_EXECUTOR
+LIBSEL4_INLINE_FUNC seL4_Error seL4_AsyncSubmit(seL4_TCB executor, seL4_CPtr ring)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    seL4_Word unused2 = 0;
+    seL4_Word unused3 = 0;
+    seL4_Word unused4 = 0;
+
+    riscv_sys_send_recv(seL4_SysAsyncSubmit, executor, &executor, ring, &unused0, &unused1,
+                        &unused2, &unused3, &unused4, 0);
+    return (seL4_Error)executor;
+}
+#endif /* CONFIG_ASYNC_EXECUTOR */
+
+#ifdef CONFIG_RISCV_EXT_V
+LIBSEL4_INLINE_FUNC seL4_Error seL4_SetVectorState(seL4_CPtr frame)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    seL4_Word unused2 = 0;
+    seL4_Word unused3 = 0;
+    seL4_Word unused4 = 0;
+
+    riscv_sys_send_recv(seL4_SysSetVectorState, frame, &frame, 0, &unused0, &unused1,
+                        &unused2, &unused3, &unused4, 0);
+    return (seL4_Error)frame;
+}
+#endif /* CONFIG_RISCV_EXT_V */
@@ -0,0 +1,30 @@
+/*
+ * Copyright 2020, Data61, CSIRO (ABN 41 687 119 230)
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <autoconf.h>
+
+#if defined(CONFIG_BENCHMARK_GENERIC) && defined(CONFIG_ENABLE_SMP_SUPPORT)
+/* Written to the IPC buffer by seL4_BenchmarkFinalizeLog, for the current
+ * core since its last seL4_BenchmarkResetLog */
+enum benchmark_lock_ipc_index {
+    /* Times big_kernel_lock was taken, and the cycles spent waiting for it */
+    BENCHMARK_LOCK_ACQUISITIONS,
+    BENCHMARK_LOCK_WAIT_CYCLES,
+#ifdef CONFIG_FINE_GRAINED_LOCKING
+    /* Fastpaths completed under the shared lock, and ones that had to take
+     * big_kernel_lock to fall back to the slowpath */
+    BENCHMARK_LOCK_SHARED_FASTPATHS,
+    BENCHMARK_LOCK_UPGRADES,
+#endif
+#ifdef CONFIG_LOCAL_SYSCALLS
+    /* Syscalls run without big_kernel_lock */
+    BENCHMARK_LOCK_LOCAL_SYSCALLS,
+#endif
+    BENCHMARK_LOCK_NUM_VALUES
+};
+#endif
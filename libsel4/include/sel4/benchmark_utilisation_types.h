@@ -40,6 +40,73 @@ enum benchmark_track_util_ipc_index {
     BENCHMARK_TOTAL_KERNEL_UTILISATION,
     /* Total number of times the kernel is entered on the current core */
     BENCHMARK_TOTAL_NUMBER_KERNEL_ENTRIES,
+#ifdef CONFIG_CROSSCORE_FASTPATH
+    /* Number of Signals to a thread on another core done on the fastpath, and
+     * the cycles from their kernel entry until the IPI was sent */
+    BENCHMARK_TOTAL_CROSSCORE_FASTPATH,
+    BENCHMARK_TOTAL_CROSSCORE_FASTPATH_CYCLES,
+#endif
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+    /* Fastpath cap lookups served from, and missing, the lookup cache */
+    BENCHMARK_TOTAL_CAP_CACHE_HITS,
+    BENCHMARK_TOTAL_CAP_CACHE_MISSES,
+#endif
+#ifdef CONFIG_BATCH_INVOCATION
+    /* Invocations completed through seL4_BatchInvoke, and the cycles spent
+     * performing them */
+    BENCHMARK_TOTAL_BATCH_INVOCATIONS,
+    BENCHMARK_TOTAL_BATCH_CYCLES,
+#endif
+#ifdef CONFIG_ASYNC_EXECUTOR
+    /* Invocations performed by executors on this core, rings they emptied and
+     * the cycles spent performing the invocations */
+    BENCHMARK_TOTAL_ASYNC_INVOCATIONS,
+    BENCHMARK_TOTAL_ASYNC_COMPLETIONS,
+    BENCHMARK_TOTAL_ASYNC_CYCLES,
+#endif
+#ifdef CONFIG_RELEASE_SLACK
+    /* Timer interrupts saved by releasing threads together */
+    BENCHMARK_TOTAL_COALESCED_RELEASES,
+#endif
+#ifdef CONFIG_WORK_STEALING
+    /* Threads this core pulled from another one, and threads it migrated */
+    BENCHMARK_TOTAL_STEALS,
+    BENCHMARK_TOTAL_MIGRATIONS,
+#endif
+#ifdef CONFIG_WAKEUP_INBOX
+    /* Threads other cores woke on this core through its inbox */
+    BENCHMARK_TOTAL_INBOX_WAKEUPS,
+#endif
+#ifdef CONFIG_TARGETED_REMOTE_CALLS
+    /* Remote calls this core posted */
+    BENCHMARK_TOTAL_REMOTE_CALLS,
+#endif
+#ifdef CONFIG_ARCH_RISCV
+    /* Timer deadlines set and IPIs sent by this core, and the cycles spent
+     * on them, with or without Sstc and the SBI extensions */
+    BENCHMARK_TOTAL_TIMER_PROGRAMS,
+    BENCHMARK_TOTAL_TIMER_PROGRAM_CYCLES,
+    BENCHMARK_TOTAL_IPI_SENDS,
+    BENCHMARK_TOTAL_IPI_SEND_CYCLES,
+    /* Timer interrupts taken, and the cycles spent handling them including
+     * setting the next deadline */
+    BENCHMARK_TOTAL_TIMER_IRQS,
+    BENCHMARK_TOTAL_TIMER_IRQ_CYCLES,
+    /* Kernel entries through a C handler, and the cycles from taking the trap
+     * to reaching that handler and taking its lock, with or without the kernel
+     * page table switch */
+    BENCHMARK_TOTAL_TRAP_ENTRIES,
+    BENCHMARK_TOTAL_TRAP_ENTRY_CYCLES,
+    /* The Call and ReplyRecv entries among them, with or without the
+     * partial register save */
+    BENCHMARK_TOTAL_IPC_TRAP_ENTRIES,
+    BENCHMARK_TOTAL_IPC_TRAP_ENTRY_CYCLES,
+#endif
+#ifdef CONFIG_RISCV_IRQ_BATCH
+    /* External interrupt entries, and the IRQs they signalled between them */
+    BENCHMARK_TOTAL_IRQ_BATCH_ENTRIES,
+    BENCHMARK_TOTAL_IRQ_BATCH_IRQS,
+#endif
 };
 
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
@@ -74,11 +74,22 @@ typedef enum {
 
 #ifdef CONFIG_KERNEL_MCS
 /* Minimum size of a scheduling context (2^{n} bytes) */
+#if defined(CONFIG_RELEASE_SLACK) && CONFIG_WORD_SIZE == 64
+#define seL4_MinSchedContextBits 8
+#else
 #define seL4_MinSchedContextBits 7
+#endif
 #ifndef __ASSEMBLER__
+#ifdef CONFIG_RELEASE_SLACK
+/* The size of a scheduling context, including the minimum 2 refills and the
+   slot holding the slack, excluding any extra refills
+   (= 10 words, 2 tick_t, 3 refills (= 2 tick_t each)) */
+#define seL4_CoreSchedContextBytes (10 * sizeof(seL4_Word) + (8 * 8))
+#else
 /* The size of a scheduling context, including the minimum 2 refills, excluding
    any extra refills (= 10 words, 2 tick_t, 2 refills (= 2 tick_t each)) */
 #define seL4_CoreSchedContextBytes (10 * sizeof(seL4_Word) + (6 * 8))
+#endif
 /* the size of a single extra refill */
 #define seL4_RefillSizeBytes (2 * 8)
 SEL4_COMPILE_ASSERT(MinSchedContextBits_min_1, seL4_MinSchedContextBits > 1)
@@ -106,6 +117,14 @@ typedef enum {
     SEL4_FORCE_LONG_ENUM(seL4_SchedContextFlag),
 } seL4_SchedContextFlag;
 
+#ifdef CONFIG_RELEASE_SLACK
+/* The flags above this bit are the slack of the scheduling context in
+ * microseconds: its releases may be delayed by up to the slack to share
+ * a timer interrupt with other releases */
+#define seL4_SchedContext_SlackShift 16
+#define seL4_SchedContext_Slack(us) ((seL4_Word)(us) << seL4_SchedContext_SlackShift)
+#endif
+
 #endif /* !__ASSEMBLER__ */
 #endif /* CONFIG_KERNEL_MCS */
 
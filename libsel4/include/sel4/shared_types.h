@@ -20,6 +20,31 @@ typedef struct seL4_IPCBuffer_ {
     seL4_Word rt_addr;
 } seL4_IPCBuffer __attribute__((__aligned__(sizeof(struct seL4_IPCBuffer_))));
 
+#ifdef CONFIG_BATCH_INVOCATION
+/* Number of message registers carried by a batched invocation */
+#define seL4_BatchMsgLength 10
+
+/* An invocation queued on a batch ring. Once completed, tag and msg hold the
+ * reply, with the seL4_Error of the invocation as the label. */
+typedef struct seL4_BatchEntry_ {
+    seL4_CPtr service;
+    seL4_MessageInfo_t tag;
+    seL4_Word msg[seL4_BatchMsgLength];
+    seL4_CPtr caps[seL4_MsgMaxExtraCaps];
+    seL4_Word padding;
+} seL4_BatchEntry;
+
+/* Header at the start of a batch ring frame, the entries follow it. Userland
+ * queues entries and advances tail, the kernel completes them in order and
+ * advances head. Both indices are free running and taken modulo the number of
+ * entries that fit in the frame. */
+typedef struct seL4_BatchRing_ {
+    seL4_Word head;
+    seL4_Word tail;
+    seL4_Word padding[sizeof(seL4_BatchEntry) / sizeof(seL4_Word) - 2];
+} seL4_BatchRing;
+#endif
+
 typedef enum {
     seL4_CapFault_IP,
     seL4_CapFault_Addr,
@@ -188,6 +188,7 @@ seL4_DebugRun(void (* userfn)(void *), void *userarg);
  *    3. `BENCHMARK_TRACK_UTILISATION`: resets benchmark and current thread
  *        start time (to the time of invoking this syscall), resets idle
  *        thread utilisation to 0, and starts tracking utilisation.
+ *    4. `BENCHMARK_GENERIC` on SMP: resets the lock statistics of the current core.
  *
  * @return A `seL4_Error` error if the user-level log buffer has not been set by the user
  *                         (`BENCHMARK_TRACEPOINTS`/`BENCHMARK_TRACK_KERNEL_ENTRIES`).
@@ -203,6 +204,8 @@ seL4_BenchmarkResetLog(void);
  *    1. `BENCHMARK_TRACEPOINTS`: Sets the final log buffer index to the current index,
  *    2. `BENCHMARK_TRACK_KERNEL_ENTRIES`:  as above,
  *    3. `BENCHMARK_TRACK_UTILISATION`: sets benchmark end time to current time, stops tracking utilisation.
+ *    4. `BENCHMARK_GENERIC` on SMP: writes the lock statistics of the current core to the IPC buffer,
+ *        indexed by `enum benchmark_lock_ipc_index`.
  *
  * @return The index of the final entry in the log buffer (if `BENCHMARK_TRACEPOINTS`/`BENCHMARK_TRACK_KERNEL_ENTRIES` are enabled).
  *
@@ -390,3 +393,84 @@ LIBSEL4_INLINE_FUNC void
 seL4_SetTLSBase(seL4_Word tls_base);
 #endif
 
+#ifdef CONFIG_BATCH_INVOCATION
+/**
+ * @xmlonly <manual name="Batch Invoke" label="sel4_batchinvoke"/> @endxmlonly
+ * @brief Perform the invocations queued on a batch ring.
+ *
+ * Performs the invocations between `head` and `tail` of the `seL4_BatchRing`
+ * at the start of `ring`, in order, as if each were an `seL4_Call` on its
+ * `service`. The reply of each invocation is written back to its entry and
+ * `head` is advanced past it. Invocations on endpoint, notification and reply
+ * capabilities, and invocations whose capabilities can't be looked up, fail
+ * with an error instead of blocking or faulting.
+ *
+ * The system call returns once the ring is empty or the current thread stops
+ * running. If it is preempted it is restarted, continuing from `head`. The
+ * message registers and extra caps in the caller's IPC buffer are clobbered.
+ *
+ * @param[in] ring A capability to a writable, non-device frame holding the ring.
+ * @return A `seL4_InvalidCapability` error if `ring` is not such a frame.
+ */
+LIBSEL4_INLINE_FUNC seL4_Error
+seL4_BatchInvoke(seL4_CPtr ring);
+#endif
+
+#ifdef CONFIG_ASYNC_EXECUTOR
+/**
+ * @xmlonly <manual name="Async Submit" label="sel4_asyncsubmit"/> @endxmlonly
+ * @brief Hand a batch ring to an executor thread without waiting for it.
+ *
+ * Queues `executor` on the core it has affinity with and returns. That core
+ * performs the invocations of the ring as `seL4_BatchInvoke` would for
+ * `executor`, using its CSpace and IPC buffer, and sets the `uintr_flag` in
+ * the IPC buffer of `executor` once the ring is empty. The flag is cleared by
+ * this system call. The executor must not be running: it is kept in
+ * `ThreadState_BlockedOnExecutor` while queued and is inactive otherwise.
+ *
+ * Submitting to an executor that is still queued only picks up the entries
+ * past the old `tail`. Nothing is performed before this system call returns.
+ * An executor with affinity to another core is started by an IPI to that
+ * core, one with affinity to the current core at its next timer tick. Each
+ * time a core drains its queue, every executor on it performs at most
+ * `CONFIG_ASYNC_EXECUTOR_BUDGET` entries, and the rest of its ring waits for
+ * the next timer tick or IPI on that core.
+ *
+ * @param[in] executor A capability to the TCB of the executor.
+ * @param[in] ring A capability to the ring frame in the CSpace of `executor`.
+ * @return A `seL4_IllegalOperation` error if `executor` is the current thread
+ *         or is not stopped, `seL4_InvalidCapability` if either capability is
+ *         of the wrong type and `seL4_NotEnoughMemory` if the executor queue of
+ *         its core is full.
+ */
+LIBSEL4_INLINE_FUNC seL4_Error
+seL4_AsyncSubmit(seL4_TCB executor, seL4_CPtr ring);
+#endif
+
+#ifdef CONFIG_RISCV_EXT_V
+/**
+ * @xmlonly <manual name="Set Vector State" label="sel4_setvectorstate"/> @endxmlonly
+ * @brief Enable the vector extension for the current thread
+ *
+ * Vector instructions of the current thread trap until it has a frame to hold
+ * its vector registers. The registers are loaded from the frame on the first
+ * vector instruction after another thread used them, and saved to it only if
+ * they were modified. The frame has to be at least as large as the vector
+ * register file, which is `32 * CONFIG_RISCV_VLENB` bytes, plus four words.
+ *
+ * The kernel keeps a copy of the frame capability. Once the frame is revoked,
+ * the next vector instruction of the thread raises a user exception, and
+ * registers the thread modified since it last got them are lost. At most
+ * `CONFIG_RISCV_VECTOR_THREADS` threads can have a vector state frame.
+ *
+ * @param[in] frame A capability to a writable frame in the CSpace of the
+ *                  current thread, or `seL4_CapNull` to disable the extension.
+ * @return A `seL4_InvalidCapability` error if `frame` is not a large enough
+ *         writable frame, `seL4_IllegalOperation` if the vector length of
+ *         the hart is not `CONFIG_RISCV_VLENB` and `seL4_NotEnoughMemory` if
+ *         too many threads use the vector extension.
+ */
+LIBSEL4_INLINE_FUNC seL4_Error
+seL4_SetVectorState(seL4_CPtr frame);
+#endif
+
@@ -0,0 +1,259 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <config.h>
+
+#ifdef CONFIG_BATCH_INVOCATION
+
+#include <types.h>
+#include <api/batch.h>
+#include <api/failures.h>
+#include <api/syscall.h>
+#include <kernel/cspace.h>
+#include <kernel/thread.h>
+#include <kernel/vspace.h>
+#include <model/preemption.h>
+#include <model/statedata.h>
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+#include <fastpath/fastpath.h>
+#endif
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+#include <benchmark/benchmark_utilisation.h>
+#endif
+
+compile_assert(batch_ring_header_is_an_entry, sizeof(seL4_BatchRing) == sizeof(seL4_BatchEntry))
+
+/* The caller's registers that are overwritten to pass each invocation to
+ * handleInvocation, restored once the batch stops. */
+#define N_BATCH_SAVED_REGISTERS (2 + n_msgRegisters)
+
+static void batch_save_registers(tcb_t *thread, word_t *saved)
+{
+    word_t i;
+
+    saved[0] = getRegister(thread, capRegister);
+    saved[1] = getRegister(thread, msgInfoRegister);
+    for (i = 0; i < n_msgRegisters; i++) {
+        saved[i + 2] = getRegister(thread, msgRegisters[i]);
+    }
+}
+
+static void batch_restore_registers(tcb_t *thread, word_t *saved)
+{
+    word_t i;
+
+    setRegister(thread, capRegister, saved[0]);
+    setRegister(thread, msgInfoRegister, saved[1]);
+    for (i = 0; i < n_msgRegisters; i++) {
+        setRegister(thread, msgRegisters[i], saved[i + 2]);
+    }
+}
+
+static void batch_entry_set_error(seL4_BatchEntry *entry, seL4_Error error)
+{
+    entry->tag = seL4_MessageInfo_new(error, 0, 0, 0);
+}
+
+/* An executor is made the current thread of the core for its invocations, in
+ * the middle of the kernel entry of another thread. Only objects whose
+ * invocations act on neither the current thread nor the scheduler can be
+ * invoked there:
+ * - untyped: UntypedRetype
+ * - frame, page table: the Map, Unmap, GetAddress and cache maintenance
+ *   invocations of the architecture
+ * - ASID control and pool: MakePool and Assign
+ * - IRQ handler: Ack, SetNotification and Clear
+ * None of these blocks the caller or wakes a thread, executor_run asserts
+ * that the current thread and the scheduler action are left alone. */
+static bool_t batch_executor_may_invoke(cap_t cap)
+{
+    switch (cap_get_capType(cap)) {
+    case cap_untyped_cap:
+    case cap_frame_cap:
+    case cap_page_table_cap:
+    case cap_asid_control_cap:
+    case cap_asid_pool_cap:
+    case cap_irq_handler_cap:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* Performs one entry as a Call from the current thread. Invocations that would
+ * block the caller or raise a fault are failed here instead, as the rest of
+ * the batch would otherwise stall behind them. The ring is shared with
+ * userland, so the request is copied out once and only the copy is used. */
+exception_t batch_invoke(tcb_t *thread, word_t *buffer, seL4_BatchEntry *entry, bool_t fromExecutor)
+{
+    seL4_MessageInfo_t info;
+    lookupCap_ret_t lu_ret;
+    exception_t status;
+    seL4_BatchEntry request;
+    word_t length, extraCaps, i;
+
+    request = *entry;
+
+    info = messageInfoFromWord(request.tag.words[0]);
+    length = seL4_MessageInfo_get_length(info);
+    if (length > seL4_BatchMsgLength) {
+        length = seL4_BatchMsgLength;
+        info = seL4_MessageInfo_set_length(info, length);
+    }
+    /* Without a writable IPC buffer only the register part of the message can
+     * be passed on */
+    if (buffer == NULL) {
+        if (length > n_msgRegisters) {
+            length = n_msgRegisters;
+            info = seL4_MessageInfo_set_length(info, length);
+        }
+        info = seL4_MessageInfo_set_extraCaps(info, 0);
+    }
+    extraCaps = seL4_MessageInfo_get_extraCaps(info);
+
+    lu_ret = lookupCap(thread, request.service);
+    if (unlikely(lu_ret.status != EXCEPTION_NONE)) {
+        batch_entry_set_error(entry, seL4_InvalidCapability);
+        return EXCEPTION_NONE;
+    }
+
+    switch (cap_get_capType(lu_ret.cap)) {
+    case cap_endpoint_cap:
+    case cap_notification_cap:
+    case cap_reply_cap:
+        batch_entry_set_error(entry, seL4_IllegalOperation);
+        return EXCEPTION_NONE;
+    default:
+        break;
+    }
+
+    if (fromExecutor && !batch_executor_may_invoke(lu_ret.cap)) {
+        batch_entry_set_error(entry, seL4_IllegalOperation);
+        return EXCEPTION_NONE;
+    }
+
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+    fastpath_cap_cache_check_invocation(lu_ret.cap);
+#endif
+
+    for (i = 0; i < extraCaps; i++) {
+        if (unlikely(lookupCap(thread, request.caps[i]).status != EXCEPTION_NONE)) {
+            batch_entry_set_error(entry, seL4_InvalidCapability);
+            return EXCEPTION_NONE;
+        }
+    }
+
+    setRegister(thread, capRegister, request.service);
+    setRegister(thread, msgInfoRegister, wordFromMessageInfo(info));
+    for (i = 0; i < length && i < n_msgRegisters; i++) {
+        setRegister(thread, msgRegisters[i], request.msg[i]);
+    }
+    for (; i < length; i++) {
+        buffer[i + 1] = request.msg[i];
+    }
+    for (i = 0; i < extraCaps; i++) {
+        buffer[seL4_MsgMaxLength + 2 + i] = request.caps[i];
+    }
+
+    status = handleInvocation(true, true);
+    if (unlikely(status != EXCEPTION_NONE)) {
+        return status;
+    }
+
+    info = messageInfoFromWord(getRegister(thread, msgInfoRegister));
+    length = seL4_MessageInfo_get_length(info);
+    if (length > seL4_BatchMsgLength) {
+        length = seL4_BatchMsgLength;
+        info = seL4_MessageInfo_set_length(info, length);
+    }
+    for (i = 0; i < length && i < n_msgRegisters; i++) {
+        entry->msg[i] = getRegister(thread, msgRegisters[i]);
+    }
+    for (; i < length; i++) {
+        entry->msg[i] = buffer ? buffer[i + 1] : 0;
+    }
+    entry->tag = info;
+
+    return EXCEPTION_NONE;
+}
+
+exception_t handle_SysBatchInvoke(void)
+{
+    tcb_t *thread = NODE_STATE(ksCurThread);
+    word_t saved[N_BATCH_SAVED_REGISTERS];
+    seL4_BatchRing *ring;
+    seL4_BatchEntry *entries;
+    lookupCap_ret_t lu_ret;
+    word_t *buffer;
+    word_t nentries, head, tail;
+    exception_t status = EXCEPTION_NONE;
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    timestamp_t start;
+#endif
+
+    lu_ret = lookupCap(thread, getRegister(thread, capRegister));
+    if (unlikely(lu_ret.status != EXCEPTION_NONE ||
+                 cap_get_capType(lu_ret.cap) != cap_frame_cap ||
+                 cap_frame_cap_get_capFIsDevice(lu_ret.cap) ||
+                 cap_frame_cap_get_capFVMRights(lu_ret.cap) != VMReadWrite)) {
+        userError("SysBatchInvoke: ring is not a writable frame");
+        setRegister(thread, capRegister, seL4_InvalidCapability);
+        return EXCEPTION_NONE;
+    }
+
+    ring = (seL4_BatchRing *)cap_frame_cap_get_capFBasePtr(lu_ret.cap);
+    entries = (seL4_BatchEntry *)(ring + 1);
+    nentries = BIT(pageBitsForSize(cap_frame_cap_get_capFSize(lu_ret.cap))) / sizeof(seL4_BatchEntry) - 1;
+    buffer = lookupIPCBuffer(true, thread);
+
+    batch_save_registers(thread, saved);
+
+    /* The ring is shared with userland, so only our own copies of the indices
+     * are trusted */
+    head = ring->head;
+    tail = ring->tail;
+    while (head != tail) {
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+        start = timestamp();
+#endif
+        status = batch_invoke(thread, buffer, &entries[head % nentries], false);
+        if (unlikely(status != EXCEPTION_NONE)) {
+            break;
+        }
+
+        head++;
+        ring->head = head;
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+        NODE_STATE(benchmark_batch_invocations)++;
+        NODE_STATE(benchmark_batch_cycles) += timestamp() - start;
+#endif
+
+        /* e.g. the caller suspended itself */
+        if (unlikely(thread_state_get_tsType(thread->tcbState) != ThreadState_Running)) {
+            break;
+        }
+
+        status = preemptionPoint();
+        if (unlikely(status != EXCEPTION_NONE)) {
+            setThreadState(thread, ThreadState_Restart);
+            break;
+        }
+    }
+
+    batch_restore_registers(thread, saved);
+
+    /* When preempted the caller is left to restart the system call, which
+     * continues from head once the pending interrupt has been taken on the
+     * way back to user level */
+    if (status == EXCEPTION_NONE) {
+        setRegister(thread, capRegister, seL4_NoError);
+    }
+
+    schedule();
+    activateThread();
+
+    return EXCEPTION_NONE;
+}
+
+#endif /* CONFIG_BATCH_INVOCATION */
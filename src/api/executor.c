@@ -0,0 +1,275 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <config.h>
+
+#ifdef CONFIG_ASYNC_EXECUTOR
+
+#include <types.h>
+#include <api/batch.h>
+#include <api/executor.h>
+#include <api/failures.h>
+#include <kernel/cspace.h>
+#include <kernel/thread.h>
+#include <kernel/vspace.h>
+#include <model/statedata.h>
+#include <smp/ipi.h>
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+#include <benchmark/benchmark_utilisation.h>
+#endif
+
+static inline word_t executor_core(tcb_t *executor)
+{
+    return SMP_TERNARY(executor->tcbAffinity, 0);
+}
+
+static bool_t executor_enqueue(word_t core, tcb_t *executor)
+{
+    executor_queue_t *queue = &NODE_STATE_ON_CORE(ksExecutorQueue, core);
+
+    if (queue->tail - queue->head == CONFIG_ASYNC_EXECUTOR_QUEUE_LENGTH) {
+        return false;
+    }
+    queue->executors[queue->tail % CONFIG_ASYNC_EXECUTOR_QUEUE_LENGTH] = executor;
+    queue->tail++;
+    return true;
+}
+
+/* Another core is sent an IPI. The current core isn't drained here, as that
+ * would run a whole budget inside the submitter's system call, so its
+ * executors wait for the next timer tick or IPI. */
+static void executor_kick(word_t core)
+{
+#ifdef ENABLE_SMP_SUPPORT
+    if (core != getCurrentCPUIndex()) {
+        ipi_send_mask(CORE_IRQ_TO_IRQT(0, irq_async_syscall_ipi), BIT(core), false);
+    }
+#endif
+}
+
+/* Looks the ring up in the CSpace of the executor, as it is the executor that
+ * the invocations are performed for */
+static seL4_BatchRing *executor_lookup_ring(tcb_t *executor, cptr_t cptr, word_t *nentries)
+{
+    lookupCap_ret_t lu_ret;
+
+    lu_ret = lookupCap(executor, cptr);
+    if (unlikely(lu_ret.status != EXCEPTION_NONE ||
+                 cap_get_capType(lu_ret.cap) != cap_frame_cap ||
+                 cap_frame_cap_get_capFIsDevice(lu_ret.cap) ||
+                 cap_frame_cap_get_capFVMRights(lu_ret.cap) != VMReadWrite)) {
+        return NULL;
+    }
+
+    *nentries = BIT(pageBitsForSize(cap_frame_cap_get_capFSize(lu_ret.cap))) / sizeof(seL4_BatchEntry) - 1;
+    return (seL4_BatchRing *)cap_frame_cap_get_capFBasePtr(lu_ret.cap);
+}
+
+/* Performs up to a budget of ring entries for one executor, as the current
+ * thread of this core, and queues it again if entries are left. Returns the
+ * status of a preempted invocation, which is restarted on the next run. */
+static exception_t executor_run(tcb_t *executor)
+{
+    tcb_t *cur = NODE_STATE(ksCurThread);
+    UNUSED tcb_t *action = NODE_STATE(ksSchedulerAction);
+    seL4_BatchRing *ring;
+    seL4_BatchEntry *entries;
+    word_t *buffer;
+    word_t ringCPtr, nentries, head, tail, budget;
+    exception_t status = EXCEPTION_NONE;
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    timestamp_t start;
+#endif
+
+    ringCPtr = getRegister(executor, capRegister);
+    ring = executor_lookup_ring(executor, ringCPtr, &nentries);
+    if (unlikely(ring == NULL)) {
+        /* The ring was deleted after it was submitted */
+        thread_state_ptr_set_tsType(&executor->tcbState, ThreadState_Inactive);
+        return EXCEPTION_NONE;
+    }
+    entries = (seL4_BatchEntry *)(ring + 1);
+    buffer = lookupIPCBuffer(true, executor);
+
+    /* The executor never runs at user level, so only the invocations see it
+     * as running. This is only sound because batch_invoke limits it to the
+     * invocations listed at batch_executor_may_invoke, which neither act on
+     * the current thread nor run the scheduler. */
+    thread_state_ptr_set_tsType(&executor->tcbState, ThreadState_Running);
+    NODE_STATE(ksCurThread) = executor;
+
+    head = ring->head;
+    tail = ring->tail;
+    for (budget = CONFIG_ASYNC_EXECUTOR_BUDGET; head != tail && budget > 0; budget--) {
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+        start = timestamp();
+#endif
+        status = batch_invoke(executor, buffer, &entries[head % nentries], true);
+        assert(NODE_STATE(ksCurThread) == executor);
+        assert(NODE_STATE(ksSchedulerAction) == action);
+        if (unlikely(status != EXCEPTION_NONE)) {
+            break;
+        }
+
+        head++;
+        ring->head = head;
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+        NODE_STATE(benchmark_async_invocations)++;
+        NODE_STATE(benchmark_async_cycles) += timestamp() - start;
+#endif
+
+        if (unlikely(thread_state_get_tsType(executor->tcbState) != ThreadState_Running)) {
+            break;
+        }
+    }
+
+    NODE_STATE(ksCurThread) = cur;
+    setRegister(executor, capRegister, ringCPtr);
+
+    /* The preempted invocation left the executor in Restart. There is room
+     * to queue it again, as it was just taken off the queue. */
+    if (unlikely(status != EXCEPTION_NONE)) {
+        thread_state_ptr_set_tsType(&executor->tcbState, ThreadState_BlockedOnExecutor);
+        executor_enqueue(CURRENT_CPU_INDEX(), executor);
+        return status;
+    }
+
+    /* e.g. the executor suspended itself */
+    if (unlikely(thread_state_get_tsType(executor->tcbState) != ThreadState_Running)) {
+        return EXCEPTION_NONE;
+    }
+
+    if (head != tail) {
+        thread_state_ptr_set_tsType(&executor->tcbState, ThreadState_BlockedOnExecutor);
+        executor_enqueue(CURRENT_CPU_INDEX(), executor);
+        return EXCEPTION_NONE;
+    }
+
+    thread_state_ptr_set_tsType(&executor->tcbState, ThreadState_Inactive);
+    if (buffer != NULL) {
+        ((seL4_IPCBuffer *)buffer)->uintr_flag = 1;
+    }
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    NODE_STATE(benchmark_async_completions)++;
+#endif
+    return EXCEPTION_NONE;
+}
+
+/* Executors queued again are left for the next drain, so that each gets one
+ * budget per drain. That is the next timer tick or IPI this core takes,
+ * rather than an IPI to itself, so that a core with long rings still gets
+ * back to user level. The timer tick makes sure the drain always comes. */
+void executorQueueDrain(void)
+{
+    executor_queue_t *queue = &NODE_STATE(ksExecutorQueue);
+    word_t n = queue->tail - queue->head;
+    tcb_t *executor;
+
+    for (; n > 0; n--) {
+        executor = queue->executors[queue->head % CONFIG_ASYNC_EXECUTOR_QUEUE_LENGTH];
+        queue->head++;
+
+        /* Suspending an executor takes it out of BlockedOnExecutor but can't
+         * take it off the queue, so it is dropped here instead */
+        if (thread_state_get_tsType(executor->tcbState) != ThreadState_BlockedOnExecutor) {
+            continue;
+        }
+
+        if (unlikely(executor_core(executor) != CURRENT_CPU_INDEX())) {
+            /* The affinity changed after the executor was queued */
+            if (executor_enqueue(executor_core(executor), executor)) {
+                executor_kick(executor_core(executor));
+            } else {
+                thread_state_ptr_set_tsType(&executor->tcbState, ThreadState_Inactive);
+            }
+            continue;
+        }
+
+        if (unlikely(executor_run(executor) != EXCEPTION_NONE)) {
+            /* The pending interrupt is taken on the way back to user level */
+            break;
+        }
+    }
+}
+
+/* Called on deletion, as the queues would otherwise point to a freed TCB. A
+ * suspended executor is only dropped by the next drain, so every queue is
+ * searched regardless of the thread state. The queues are only used with
+ * big_kernel_lock held. */
+void executorQueueRemove(tcb_t *tcb)
+{
+    executor_queue_t *queue;
+    tcb_t *executor;
+    word_t core, i, kept;
+
+    for (core = 0; core < CONFIG_MAX_NUM_NODES; core++) {
+        queue = &NODE_STATE_ON_CORE(ksExecutorQueue, core);
+        kept = queue->head;
+        for (i = queue->head; i != queue->tail; i++) {
+            executor = queue->executors[i % CONFIG_ASYNC_EXECUTOR_QUEUE_LENGTH];
+            if (executor != tcb) {
+                queue->executors[kept % CONFIG_ASYNC_EXECUTOR_QUEUE_LENGTH] = executor;
+                kept++;
+            }
+        }
+        queue->tail = kept;
+    }
+}
+
+exception_t handle_SysAsyncSubmit(void)
+{
+    tcb_t *thread = NODE_STATE(ksCurThread);
+    lookupCap_ret_t lu_ret;
+    tcb_t *executor;
+    word_t *buffer;
+    word_t ringCPtr, nentries;
+
+    lu_ret = lookupCap(thread, getRegister(thread, capRegister));
+    if (unlikely(lu_ret.status != EXCEPTION_NONE || cap_get_capType(lu_ret.cap) != cap_thread_cap)) {
+        userError("SysAsyncSubmit: executor is not a TCB");
+        setRegister(thread, capRegister, seL4_InvalidCapability);
+        return EXCEPTION_NONE;
+    }
+
+    executor = TCB_PTR(cap_thread_cap_get_capTCBPtr(lu_ret.cap));
+    if (unlikely(executor == thread ||
+                 (thread_state_get_tsType(executor->tcbState) != ThreadState_Inactive &&
+                  thread_state_get_tsType(executor->tcbState) != ThreadState_BlockedOnExecutor))) {
+        userError("SysAsyncSubmit: executor is not stopped");
+        setRegister(thread, capRegister, seL4_IllegalOperation);
+        return EXCEPTION_NONE;
+    }
+
+    ringCPtr = getRegister(thread, msgInfoRegister);
+    if (unlikely(executor_lookup_ring(executor, ringCPtr, &nentries) == NULL)) {
+        userError("SysAsyncSubmit: ring is not a writable frame");
+        setRegister(thread, capRegister, seL4_InvalidCapability);
+        return EXCEPTION_NONE;
+    }
+
+    if (thread_state_get_tsType(executor->tcbState) == ThreadState_Inactive) {
+        if (unlikely(!executor_enqueue(executor_core(executor), executor))) {
+            userError("SysAsyncSubmit: executor queue is full");
+            setRegister(thread, capRegister, seL4_NotEnoughMemory);
+            return EXCEPTION_NONE;
+        }
+        thread_state_ptr_set_tsType(&executor->tcbState, ThreadState_BlockedOnExecutor);
+    }
+
+    setRegister(executor, capRegister, ringCPtr);
+    buffer = lookupIPCBuffer(true, executor);
+    if (buffer != NULL) {
+        ((seL4_IPCBuffer *)buffer)->uintr_flag = 0;
+    }
+    setRegister(thread, capRegister, seL4_NoError);
+
+    executor_kick(executor_core(executor));
+
+    schedule();
+    activateThread();
+
+    return EXCEPTION_NONE;
+}
+
+#endif /* CONFIG_ASYNC_EXECUTOR */
@@ -11,6 +11,8 @@
 #include <benchmark/benchmark_track.h>
 #include <benchmark/benchmark_utilisation.h>
 #include <api/syscall.h>
+#include <api/batch.h>
+#include <api/executor.h>
 #include <api/failures.h>
 #include <api/faults.h>
 #include <kernel/cspace.h>
@@ -24,8 +26,10 @@
 #include <string.h>
 #include <kernel/traps.h>
 #include <arch/machine.h>
+#include <arch/machine/vector.h>
 #ifdef ENABLE_SMP_SUPPORT
 #include <smp/ipi.h>
+#include <model/smp.h>
 #endif
 #ifdef CONFIG_DEBUG_BUILD
 #include <arch/machine/capdl.h>
@@ -167,6 +171,27 @@ exception_t handleUnknownSyscall(word_t w)
     }
 #endif
 
+#ifdef CONFIG_BATCH_INVOCATION
+    if (w == SysBatchInvoke)
+    {
+        return handle_SysBatchInvoke();
+    }
+#endif
+
+#ifdef CONFIG_ASYNC_EXECUTOR
+    if (w == SysAsyncSubmit)
+    {
+        return handle_SysAsyncSubmit();
+    }
+#endif
+
+#ifdef CONFIG_RISCV_EXT_V
+    if (w == SysSetVectorState)
+    {
+        return handle_SysSetVectorState();
+    }
+#endif
+
 #ifdef CONFIG_ENABLE_BENCHMARKS
     switch (w)
     {
@@ -222,6 +247,38 @@ exception_t handleUnknownSyscall(word_t w)
     return EXCEPTION_NONE;
 }
 
+#ifdef CONFIG_LOCAL_SYSCALLS
+/* Performs the syscall if it only touches the current thread and the state of
+ * this core, and returns whether it did. Called without big_kernel_lock, so
+ * nothing here may look at state another core can write. */
+bool_t handleLocalSyscall(syscall_t syscall)
+{
+    switch (syscall) {
+#ifdef CONFIG_PRINTING
+    case SysGetClock:
+        setRegister(NODE_STATE(ksCurThread), capRegister, riscv_read_cycle());
+        return true;
+#endif
+#ifdef CONFIG_ENABLE_BENCHMARKS
+    case SysBenchmarkNullSyscall:
+        return true;
+#endif
+#ifdef CONFIG_SET_TLS_BASE_SELF
+    case SysSetTLSBase:
+        Arch_setTLSRegister(getRegister(NODE_STATE(ksCurThread), capRegister));
+        return true;
+#endif
+    case SysYield:
+        /* The current thread isn't in the ready queues, so with nothing queued
+         * the scheduler would pick it again. Other cores may be queueing
+         * threads here, which is the same as them doing so just after. */
+        return __atomic_load_n(&NODE_STATE(ksReadyQueuesL1Bitmap)[ksCurDomain], __ATOMIC_RELAXED) == 0;
+    default:
+        return false;
+    }
+}
+#endif /* CONFIG_LOCAL_SYSCALLS */
+
 
 #ifdef CONFIG_KERNEL_MCS
 static exception_t handleInvocation(bool_t isCall, bool_t isBlocking, bool_t canDonate, bool_t firstPhase, cptr_t cptr)
@@ -4,6 +4,14 @@
  * SPDX-License-Identifier: GPL-2.0-only
  */
 
+#include <config.h>
+#include <types.h>
+
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+/* The cycle counter read by trap_entry when the trap was taken */
+word_t ksTrapEntryCycles[CONFIG_MAX_NUM_NODES] VISIBLE;
+#endif
+
 #ifdef CONFIG_ENABLE_BENCHMARK
 
 #endif /* CONFIG_ENABLE_BENCHMARK */
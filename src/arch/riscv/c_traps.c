@@ -8,12 +8,36 @@
 #include <config.h>
 #include <model/statedata.h>
 #include <arch/fastpath/fastpath.h>
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+#include <fastpath/fastpath.h>
+#endif
 #include <arch/kernel/traps.h>
 #include <machine/debug.h>
 #include <api/syscall.h>
 #include <util.h>
 #include <arch/machine/hardware.h>
 #include <machine/fpu.h>
+#ifdef CONFIG_RISCV_EXT_V
+#include <arch/machine/vector.h>
+#endif
+#ifdef CONFIG_RISCV_IRQ_BATCH
+#include <object/notification.h>
+#endif
+#ifdef CONFIG_ASYNC_EXECUTOR
+#include <api/executor.h>
+#endif
+#ifdef CONFIG_WORK_STEALING
+#include <model/smp.h>
+#endif
+
+#ifdef RISCV_C_INVOCATIONS
+#include <api/invocation.h>
+#include <arch/api/invocation.h>
+#include <arch/object/interrupt.h>
+#include <kernel/cspace.h>
+#include <object/endpoint.h>
+#include <object/tcb.h>
+#endif
 
 #include <benchmark/benchmark_track.h>
 #include <benchmark/benchmark_utilisation.h>
@@ -27,6 +51,11 @@ void VISIBLE c_handle_fastpath_reply_recv(word_t cptr, word_t msgInfo, word_t re
 void VISIBLE c_handle_fastpath_reply_recv(word_t cptr, word_t msgInfo)
 #endif
 {
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    /* Taken before the lock, which the other cores may hold */
+    NODE_STATE(benchmark_ipc_trap_entries)++;
+    NODE_STATE(benchmark_ipc_trap_entry_cycles) += trap_entry_cycles();
+#endif
     NODE_LOCK_SYS;
 
     c_entry_hook();
@@ -45,6 +74,11 @@ void VISIBLE c_handle_fastpath_reply_recv(word_t cptr, word_t msgInfo)
 ALIGN(L1_CACHE_LINE_SIZE)
 void VISIBLE c_handle_fastpath_call(word_t cptr, word_t msgInfo)
 {
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    /* Taken before the lock, which the other cores may hold */
+    NODE_STATE(benchmark_ipc_trap_entries)++;
+    NODE_STATE(benchmark_ipc_trap_entry_cycles) += trap_entry_cycles();
+#endif
     NODE_LOCK_SYS;
 
     c_entry_hook();
@@ -53,8 +87,423 @@ void VISIBLE c_handle_fastpath_call(word_t cptr, word_t msgInfo)
     ksKernelEntry.is_fastpath = 1;
 #endif /* DEBUG */
 
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+    cap_t cap = lookup_fp_uncounted(TCB_PTR_CTE_PTR(NODE_STATE(ksCurThread), tcbCTable)->cap, cptr);
+    fastpath_cap_cache_check_invocation(cap);
+#endif
     fastpath_call(cptr, msgInfo);
 
     UNREACHABLE();
 }
+
+#if defined(CONFIG_SEND_FASTPATH) || defined(CONFIG_SIGNAL_FASTPATH)
+ALIGN(L1_CACHE_LINE_SIZE)
+void VISIBLE c_handle_fastpath_send(word_t cptr, word_t msgInfo, syscall_t syscall)
+{
+    NODE_LOCK_SHARED;
+
+    c_entry_hook();
+#ifdef TRACK_KERNEL_ENTRIES
+    benchmark_debug_syscall_start(cptr, msgInfo, syscall);
+    ksKernelEntry.is_fastpath = 1;
+#endif /* DEBUG */
+
+#ifdef CONFIG_SEND_FASTPATH
+    /* Dispatches signals to fastpath_signal itself */
+    fastpath_send(cptr, msgInfo, syscall);
+#else
+    fastpath_signal(cptr, msgInfo);
+#endif
+
+    UNREACHABLE();
+}
+#endif
+
+#ifdef CONFIG_WAIT_FASTPATH
+ALIGN(L1_CACHE_LINE_SIZE)
+void VISIBLE c_handle_fastpath_wait(word_t cptr, word_t msgInfo, syscall_t syscall)
+{
+    NODE_LOCK_SHARED;
+
+    c_entry_hook();
+#ifdef TRACK_KERNEL_ENTRIES
+    benchmark_debug_syscall_start(cptr, msgInfo, syscall);
+    ksKernelEntry.is_fastpath = 1;
+#endif /* DEBUG */
+
+    fastpath_wait(cptr, msgInfo, syscall);
+
+    UNREACHABLE();
+}
+#endif
+
+#ifdef CONFIG_EXCEPTION_FASTPATH
+/* The exception fastpaths already hold the kernel lock, so they can't fall
+ * back to c_handle_exception. */
+void NORETURN vm_fault_slowpath(vm_fault_type_t type)
+{
+    handleVMFaultEvent(type);
+    restore_user_context();
+    UNREACHABLE();
+}
+
+void NORETURN user_exception_slowpath(void)
+{
+    handle_exception();
+    restore_user_context();
+    UNREACHABLE();
+}
+
+ALIGN(L1_CACHE_LINE_SIZE)
+void VISIBLE c_handle_fastpath_unknown_syscall(word_t cptr, word_t msgInfo, syscall_t syscall)
+{
+    NODE_LOCK_SYS;
+
+    c_entry_hook();
+#ifdef TRACK_KERNEL_ENTRIES
+    ksKernelEntry.path = Entry_UnknownSyscall;
+    ksKernelEntry.word = syscall;
+#endif /* DEBUG */
+
+    fastpath_unknown_syscall(syscall);
+
+    UNREACHABLE();
+}
+
+ALIGN(L1_CACHE_LINE_SIZE)
+void VISIBLE c_handle_fastpath_exception(void)
+{
+    NODE_LOCK_SYS;
+
+    c_entry_hook();
+
+    word_t scause = read_scause();
+#ifdef TRACK_KERNEL_ENTRIES
+    ksKernelEntry.word = scause;
+#endif /* DEBUG */
+
+    switch (scause) {
+    case RISCVInstructionAccessFault:
+    case RISCVLoadAccessFault:
+    case RISCVStoreAccessFault:
+    case RISCVLoadPageFault:
+    case RISCVStorePageFault:
+    case RISCVInstructionPageFault:
+#ifdef TRACK_KERNEL_ENTRIES
+        ksKernelEntry.path = Entry_VMFault;
+#endif
+        fastpath_vm_fault(scause);
+    default:
+#ifdef TRACK_KERNEL_ENTRIES
+        ksKernelEntry.path = Entry_UserLevelFault;
+#endif
+#ifdef CONFIG_HAVE_FPU
+        /* The first FPU instruction of a thread traps as an illegal
+         * instruction, handle_exception deals with that */
+        if (scause == RISCVInstructionIllegal && !isFpuEnable()) {
+            user_exception_slowpath();
+        }
+#endif
+        fastpath_user_exception(scause);
+    }
+
+    UNREACHABLE();
+}
+#endif
+#endif
+
+#ifdef RISCV_C_INVOCATIONS
+static inline bool_t isCInvocation(word_t label)
+{
+    switch (label) {
+#ifdef CONFIG_WORK_STEALING
+    case RISCVTCBSetMigratable:
+        return true;
+#endif
+#ifdef CONFIG_IRQ_AFFINITY
+    case RISCVIRQHandlerSetAffinity:
+    case IRQAckIRQ:
+        return true;
+#endif
+#ifdef CONFIG_IRQ_PRIORITIES
+    case RISCVIRQHandlerSetPriority:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+/* Invocations decoded in C. The decodeInvocation of the Rust part of the
+ * kernel doesn't know their labels, or doesn't know the state they depend on.
+ * Returns for anything this doesn't handle, which the slowpath then decodes
+ * and raises the lookup fault or the error for the wrong cap type for. As in
+ * handleInvocation, only Call gets a reply. */
+static void handleCInvocation(cptr_t cptr, word_t msgInfo, bool_t isCall)
+{
+    tcb_t *thread = NODE_STATE(ksCurThread);
+    seL4_MessageInfo_t info = messageInfoFromWord(msgInfo);
+    word_t length = seL4_MessageInfo_get_length(info);
+    lookupCap_ret_t lu_ret;
+    exception_t status;
+
+    lu_ret = lookupCap(thread, cptr);
+    if (lu_ret.status != EXCEPTION_NONE) {
+        return;
+    }
+
+    switch (seL4_MessageInfo_get_label(info)) {
+#ifdef CONFIG_WORK_STEALING
+    case RISCVTCBSetMigratable:
+        if (cap_get_capType(lu_ret.cap) != cap_thread_cap) {
+            return;
+        }
+        status = decodeSetMigratable(lu_ret.cap, length, lookupIPCBuffer(false, thread));
+        break;
+#endif
+#ifdef CONFIG_IRQ_AFFINITY
+    case RISCVIRQHandlerSetAffinity:
+        if (cap_get_capType(lu_ret.cap) != cap_irq_handler_cap) {
+            return;
+        }
+        status = decodeIRQHandlerSetAffinity(lu_ret.cap, length, lookupIPCBuffer(false, thread));
+        break;
+    case IRQAckIRQ:
+        /* IRQs without an affinity are acked by the Rust part of the kernel */
+        if (cap_get_capType(lu_ret.cap) != cap_irq_handler_cap ||
+            !ackRoutedIRQ(IDX_TO_IRQT(cap_irq_handler_cap_get_capIRQ(lu_ret.cap)))) {
+            return;
+        }
+        status = EXCEPTION_NONE;
+        break;
+#endif
+#ifdef CONFIG_IRQ_PRIORITIES
+    case RISCVIRQHandlerSetPriority:
+        if (cap_get_capType(lu_ret.cap) != cap_irq_handler_cap) {
+            return;
+        }
+        status = decodeIRQHandlerSetPriority(lu_ret.cap, length, lookupIPCBuffer(false, thread));
+        break;
+#endif
+    default:
+        return;
+    }
+
+    if (isCall) {
+        if (status == EXCEPTION_SYSCALL_ERROR) {
+            replyFromKernel_error(thread);
+        } else {
+            replyFromKernel_success_empty(thread);
+        }
+    }
+    restore_user_context();
+    UNREACHABLE();
+}
+
+/* Call, Send and NBSend end up here first, so the invocations decoded in C are
+ * seen whichever path would otherwise take the syscall. Everything else goes
+ * on to the entry the syscall takes without them. */
+void VISIBLE c_handle_invocation(word_t cptr, word_t msgInfo, syscall_t syscall)
+{
+    if (unlikely(isCInvocation(seL4_MessageInfo_get_label(messageInfoFromWord_raw(msgInfo))))) {
+        NODE_LOCK_SYS;
+
+        c_entry_hook();
+#ifdef TRACK_KERNEL_ENTRIES
+        benchmark_debug_syscall_start(cptr, msgInfo, syscall);
+#endif /* DEBUG */
+
+        handleCInvocation(cptr, msgInfo, syscall == SysCall);
+        slowpath(syscall);
+    }
+
+#ifdef CONFIG_FASTPATH
+    if (syscall == SysCall) {
+        c_handle_fastpath_call(cptr, msgInfo);
+    }
+#ifdef CONFIG_SEND_FASTPATH
+    c_handle_fastpath_send(cptr, msgInfo, syscall);
+#elif defined(CONFIG_SIGNAL_FASTPATH)
+    if (syscall == SysSend) {
+        c_handle_fastpath_send(cptr, msgInfo, syscall);
+    }
+#endif
+#endif
+
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+    /* As on the entry, a send that gets here may invoke a CNode or a TCB
+     * without a fastpath lookup of the cap */
+    ksFastpathCapCacheGeneration++;
+#endif
+    c_handle_syscall(cptr, msgInfo, syscall);
+}
+#endif
+
+
+#ifdef CONFIG_LOCAL_SYSCALLS
+/* Yield and the syscalls of the unknown syscall path end up here first. The
+ * ones handleLocalSyscall can do return without big_kernel_lock, the rest go
+ * on to c_handle_syscall, which takes it. */
+void VISIBLE c_handle_local_syscall(word_t cptr, word_t msgInfo, syscall_t syscall)
+{
+    /* Without the entry benchmarks this only runs the arch hook, which
+     * c_handle_syscall can run again */
+    c_entry_hook();
+
+    if (!handleLocalSyscall(syscall)) {
+        c_handle_syscall(cptr, msgInfo, syscall);
+    }
+#ifdef CONFIG_BENCHMARK_GENERIC
+    ksLockStats[getCurrentCPUIndex()].values[BENCHMARK_LOCK_LOCAL_SYSCALLS]++;
+#endif
+
+    restore_user_context();
+    UNREACHABLE();
+}
+#endif
+
+#ifdef CONFIG_RISCV_IRQ_BATCH
+extern irq_t active_irq[CONFIG_MAX_NUM_NODES];
+
+/* Does what handleInterrupt does for an IRQ bound to a notification, the IRQ
+ * is completed when the user acks it */
+static bool_t signalIRQ(irq_t irq)
+{
+    cap_t cap;
+
+    if (irq > PLIC_MAX_IRQ || intStateIRQTable[IRQT_TO_IDX(irq)] != IRQSignal) {
+        return false;
+    }
+
+    cap = intStateIRQNode[IRQT_TO_IDX(irq)].cap;
+    if (cap_get_capType(cap) == cap_notification_cap &&
+        cap_notification_cap_get_capNtfnCanSend(cap)) {
+        sendSignal(NTFN_PTR(cap_notification_cap_get_capNtfnPtr(cap)),
+                   cap_notification_cap_get_capNtfnBadge(cap));
+    }
+#ifdef CONFIG_IRQ_REPORTING
+    else {
+        printf("Undelivered IRQ: %d\n", (int)irq);
+    }
+#endif
+    return true;
+}
+
+/* External interrupts end up here first. Claims are taken until none are
+ * pending or the budget runs out, and the scheduler runs once for all of them.
+ * The first claim that isn't signalled here is left in active_irq, where
+ * getActiveIRQ returns it to handleInterruptEntry. */
+void VISIBLE c_handle_external_interrupt(void)
+{
+    word_t cpu = getCurrentCPUIndex();
+    word_t handled;
+    irq_t irq = irqInvalid;
+
+    if (active_irq[cpu] != irqInvalid) {
+        c_handle_interrupt();
+    }
+
+    NODE_LOCK_IRQ;
+
+    c_entry_hook();
+#ifdef TRACK_KERNEL_ENTRIES
+    ksKernelEntry.path = Entry_Interrupt;
+#endif
+
+    for (handled = 0; handled < CONFIG_RISCV_IRQ_BATCH_BUDGET; handled++) {
+        irq = plic_get_claim();
+        if (irq == irqInvalid) {
+            break;
+        }
+        if (!signalIRQ(irq)) {
+            active_irq[cpu] = irq;
+            break;
+        }
+    }
+
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    NODE_STATE(benchmark_irq_batch_entries)++;
+    NODE_STATE(benchmark_irq_batch_irqs) += handled;
+#endif
+
+    if (active_irq[cpu] != irqInvalid) {
+        /* This entry already holds the lock and has run the entry hook, so
+         * only the handling part of c_handle_interrupt is done. The signals
+         * sent so far are scheduled with it. */
+        handleInterruptEntry();
+        restore_user_context();
+        UNREACHABLE();
+    }
+
+    schedule();
+    activateThread();
+    restore_user_context();
+    UNREACHABLE();
+}
+#endif
+
+#ifdef RISCV_TIMER_ENTRY
+/* Timer interrupts end up here first. Every tick continues the executors
+ * queued on this core, so a ring longer than the executor budget completes
+ * even on a core that takes no IPIs. The executors run after the tick has
+ * been handled, as preemption points would otherwise find it pending. With
+ * work stealing, a core whose threads keep running until the tick preempts
+ * them kicks an idle core from here, once the tick has picked the thread it
+ * runs next. With the wakeup inbox, the entry hook splices the inbox before
+ * the tick schedules. */
+void VISIBLE c_handle_timer_interrupt(void)
+{
+    NODE_LOCK_IRQ;
+
+    c_entry_hook();
+#ifdef TRACK_KERNEL_ENTRIES
+    ksKernelEntry.path = Entry_Interrupt;
+#endif
+
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    /* Includes the reprogramming of the timer, which without MCS is done by
+     * the Rust part of the kernel */
+    timestamp_t start = timestamp();
+#endif
+    handleInterruptEntry();
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    NODE_STATE(benchmark_timer_irq_cycles) += timestamp() - start;
+    NODE_STATE(benchmark_timer_irqs)++;
+#endif
+#ifdef CONFIG_ASYNC_EXECUTOR
+    executorQueueDrain();
+#endif
+#ifdef CONFIG_WORK_STEALING
+    stealKick();
+#endif
+    restore_user_context();
+    UNREACHABLE();
+}
+#endif
+
+#ifdef CONFIG_RISCV_EXT_V
+/* Illegal instructions end up here first, the ones that aren't the first
+ * vector instruction of a thread go on to the usual exception handling */
+void VISIBLE c_handle_vector_exception(void)
+{
+    if (vectorThreadCanFault(NODE_STATE(ksCurThread)) &&
+        lookupVectorState(NODE_STATE(ksCurThread)) != NULL) {
+        NODE_LOCK_SYS;
+
+        c_entry_hook();
+#ifdef TRACK_KERNEL_ENTRIES
+        ksKernelEntry.path = Entry_UserLevelFault;
+        ksKernelEntry.word = RISCVInstructionIllegal;
+#endif
+        handleVectorFault();
+        restore_user_context();
+        UNREACHABLE();
+    }
+
+#ifdef CONFIG_EXCEPTION_FASTPATH
+    c_handle_fastpath_exception();
+#else
+    c_handle_exception();
+#endif
+}
 #endif
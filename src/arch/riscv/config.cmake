@@ -27,6 +27,63 @@ config_option(
     DEPENDS "KernelArchRiscV"
 )
 
+config_option(
+    KernelRiscvKernelIsolation RISCV_KERNEL_ISOLATION
+    "Switch to the kernel page table and flush the TLB on every trap. When disabled \
+    the kernel runs on the vspace root of the current thread, where its mappings are \
+    present as global mappings, and traps keep the TLB entries of the thread."
+    DEFAULT ON
+    DEPENDS "KernelArchRiscV"
+)
+
+config_option(
+    KernelRiscvSbiExtensions RISCV_SBI_EXTENSIONS
+    "Probe at boot for Sstc and for the TIME, IPI and RFENCE extensions of SBI \
+    v0.2. Timer deadlines are then written to stimecmp directly, and IPIs and \
+    remote fences use the extensions, falling back to the legacy SBI calls for \
+    whatever the hardware or firmware lacks."
+    DEFAULT OFF
+    DEPENDS "KernelArchRiscV"
+)
+
+config_option(
+    KernelIrqPriorities IRQ_PRIORITIES
+    "Add seL4_IRQHandler_SetPriority, which gives the interrupt of an IRQ \
+    handler the priority of the thread that handles it, so that pending \
+    interrupts are claimed in the order of their handlers. It is decoded in C \
+    on the Call, Send and NBSend entries, before the fastpaths and the \
+    slowpath. Only the claim order changes: the PLIC threshold stays at zero, \
+    so no interrupt is held back while a higher priority thread runs."
+    DEFAULT OFF
+    DEPENDS "KernelArchRiscV; NOT KernelVerificationBuild"
+)
+
+config_option(
+    KernelRiscvIrqBatch RISCV_IRQ_BATCH
+    "Handle external interrupts bound to a notification on a dedicated entry \
+    path, which keeps claiming interrupts until none are pending or the budget \
+    runs out, and runs the scheduler once for all of them."
+    DEFAULT OFF
+    DEPENDS "KernelArchRiscV; NOT KernelIsMCS; NOT KernelVerificationBuild"
+)
+
+config_string(
+    KernelRiscvIrqBatchBudget RISCV_IRQ_BATCH_BUDGET
+    "Maximum number of external interrupts handled in one kernel entry."
+    DEFAULT 8
+    DEPENDS "KernelRiscvIrqBatch"
+    UNQUOTE
+)
+
+config_option(
+    KernelRiscvSyscallPartialSave RISCV_SYSCALL_PARTIAL_SAVE
+    "Do not save the temporary registers t0-t6 on entry for seL4_Call and \
+    seL4_ReplyRecv. libsel4 marks them as clobbered by these system calls, and \
+    they return whatever the thread last had saved in them."
+    DEFAULT OFF
+    DEPENDS "KernelArchRiscV"
+)
+
 # Until RISC-V has instructions to count leading/trailing zeros, we provide
 # library implementations. Platforms that implement the bit manipulation
 # extension can override these settings to remove the library functions from
@@ -96,6 +153,7 @@ add_sources(
         machine/registerset.c
         machine/io.c
         machine/fpu.c
+        machine/vector.c
         model/statedata.c
         object/interrupt.c
         object/objecttype.c
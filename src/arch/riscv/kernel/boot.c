@@ -74,6 +74,12 @@ BOOT_CODE VISIBLE void init_kernel(
     printf("CONFIG_DEBUG_BUILD\n");
     #endif
     bool_t result;
+#ifdef CONFIG_RISCV_SBI_EXTENSIONS
+    /* before anything sets a timer or sends an IPI */
+    if (SMP_TERNARY(core_id, 0) == 0) {
+        riscv_probe_sbi();
+    }
+#endif
     pRegsToR((word_t *)avail_p_regs2, ARRAY_SIZE(avail_p_regs2));
     intStateIRQNodeToR((word_t*)intStateIRQNode);
 #ifdef ENABLE_SMP_SUPPORT
@@ -121,6 +121,20 @@ BOOT_CODE VISIBLE void map_kernel_window(void)
     /* There should be 1GiB free where we put device mapping */
     assert(pptr == UINTPTR_MAX - RISCV_GET_LVL_PGSIZE(0) + 1);
     map_kernel_devices();
+
+#ifndef CONFIG_RISCV_KERNEL_ISOLATION
+    /* Every vspace root gets these entries from copyGlobalMappings and the
+     * kernel runs on whichever root is active, so keep its translations in
+     * the TLB across ASID switches. A global non-leaf entry makes everything
+     * below it global. */
+    for (word_t i = RISCV_GET_PT_INDEX(PPTR_BASE, 0); i < BIT(PT_INDEX_BITS); i++)
+    {
+        if (pte_ptr_get_valid(&kernel_root_pageTable[i]))
+        {
+            pte_ptr_set_global(&kernel_root_pageTable[i], 1);
+        }
+    }
+#endif
 }
 
 
@@ -8,4 +8,8 @@
 #include <arch/machine/fpu.h>
 
 bool_t isFPUEnabledCached[CONFIG_MAX_NUM_NODES];
+#ifdef CONFIG_FPU_DIRTY_TRACKING
+/* Set from trap_entry, so a word per core */
+word_t fpuStateDirty[CONFIG_MAX_NUM_NODES] VISIBLE;
+#endif
 #endif
@@ -101,6 +101,16 @@ void setIRQTrigger(irq_t irq, bool_t edge_triggered)
 }
 #endif
 
+#ifdef CONFIG_IRQ_PRIORITIES
+/* Thread priorities are split into one band for each PLIC priority, and an
+ * IRQ gets the PLIC priority of the band of its handler's priority. The PLIC
+ * then hands out pending claims in the order of their handlers. */
+void setIRQPriority(irq_t irq, word_t prio)
+{
+    plic_irq_set_priority(irq, prio * plic_max_priority() / CONFIG_NUM_PRIORITIES + 1);
+}
+#endif /* CONFIG_IRQ_PRIORITIES */
+
 /* isIRQPending is used to determine whether to preempt long running
  * operations at various preemption points throughout the kernel. If this
  * returns true, it means that if the Kernel were to return to user mode, it
@@ -146,6 +156,62 @@ static inline void maskInterrupt(bool_t disable, irq_t irq)
 
 
 
+#ifdef CONFIG_RISCV_SBI_EXTENSIONS
+word_t sbi_features;
+
+/* Reading stimecmp raises an illegal instruction exception unless Sstc is
+ * implemented and enabled for S-mode, so point stvec past the read while
+ * trying it */
+static BOOT_CODE bool_t riscv_probe_sstc(void)
+{
+    word_t found = 0;
+    word_t tmp, old;
+
+    asm volatile(
+        "la %[tmp], 1f\n"
+        "csrrw %[old], stvec, %[tmp]\n"
+        "csrr %[tmp], %[stimecmp]\n"
+        "li %[found], 1\n"
+        ".align 2\n"
+        "1: csrw stvec, %[old]\n"
+        : [found] "+r"(found), [tmp] "=&r"(tmp), [old] "=&r"(old)
+        : [stimecmp] "i"(CSR_STIMECMP)
+        : "memory");
+
+    return found;
+}
+
+static BOOT_CODE bool_t sbi_probe_extension(word_t ext)
+{
+    sbi_ret_t ret = sbi_ecall(SBI_EXT_BASE, SBI_BASE_PROBE_EXTENSION, ext, 0, 0, 0, 0);
+    return ret.error == SBI_SUCCESS && ret.value != 0;
+}
+
+/* Called on the boot hart only, the other harts are assumed to be the same */
+BOOT_CODE void riscv_probe_sbi(void)
+{
+    sbi_ret_t version = sbi_ecall(SBI_EXT_BASE, SBI_BASE_GET_SPEC_VERSION, 0, 0, 0, 0, 0);
+
+    sbi_features = 0;
+    /* Firmware with only the legacy calls fails the base extension. The
+     * version is the major number in bits 24 and up and the minor below. */
+    if (version.error == SBI_SUCCESS && version.value >= 2) {
+        if (sbi_probe_extension(SBI_EXT_TIME)) {
+            sbi_features |= SBI_HAS_TIME;
+        }
+        if (sbi_probe_extension(SBI_EXT_IPI)) {
+            sbi_features |= SBI_HAS_IPI;
+        }
+        if (sbi_probe_extension(SBI_EXT_RFENCE)) {
+            sbi_features |= SBI_HAS_RFENCE;
+        }
+    }
+    if (riscv_probe_sstc()) {
+        sbi_features |= RISCV_HAS_SSTC;
+    }
+}
+#endif /* CONFIG_RISCV_SBI_EXTENSIONS */
+
 #ifndef CONFIG_KERNEL_MCS
 void resetTimer(void);
 
@@ -16,6 +16,20 @@ compile_assert(
     sizeof(msgRegisters) / sizeof(msgRegisters[0]) == n_msgRegisters
 );
 
+#ifdef CONFIG_RISCV_FAST_MESSAGE_REGISTERS
+/* Message registers past msgRegisters used by seL4_Send and seL4_NBSend.
+ * Only the send fastpath reads them, everything else takes these message
+ * registers from the IPC buffer. */
+const register_t fastMsgRegisters[] = {
+    t1, t2, t3, t4, t5, t6
+};
+compile_assert(
+    consistent_fast_message_registers,
+    CONFIG_RISCV_FAST_MESSAGE_REGISTERS >= n_msgRegisters &&
+    CONFIG_RISCV_FAST_MESSAGE_REGISTERS - n_msgRegisters <= sizeof(fastMsgRegisters) / sizeof(fastMsgRegisters[0])
+);
+#endif
+
 const register_t frameRegisters[] = {
     FaultIP, ra, sp, gp,
     s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11,
@@ -0,0 +1,179 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <config.h>
+
+#ifdef CONFIG_RISCV_EXT_V
+
+#include <types.h>
+#include <api/failures.h>
+#include <kernel/cspace.h>
+#include <kernel/thread.h>
+#include <object/cnode.h>
+#include <object/objecttype.h>
+#include <model/statedata.h>
+#include <arch/machine/vector.h>
+
+/* Each thread using the vector extension is bound to one of these slots,
+ * which holds a copy of its vector state frame cap. Revoking the frame
+ * deletes the copy through the CDT, as for the IPC buffer of a thread, so a
+ * slot that still holds a frame cap always names live memory. */
+typedef struct vector_binding {
+    cte_t slot;
+    tcb_t *thread;
+} vector_binding_t;
+
+static vector_binding_t vectorBindings[CONFIG_RISCV_VECTOR_THREADS];
+
+#define VECTOR_BINDING_PTR(_slot) ((vector_binding_t *)(_slot))
+compile_assert(vector_binding_slot_first, OFFSETOF(vector_binding_t, slot) == 0)
+
+static bool_t isVectorFrame(cap_t cap)
+{
+    return cap_get_capType(cap) == cap_frame_cap &&
+           !cap_frame_cap_get_capFIsDevice(cap) &&
+           cap_frame_cap_get_capFVMRights(cap) == VMReadWrite &&
+           BIT(pageBitsForSize(cap_frame_cap_get_capFSize(cap))) >= sizeof(user_vector_state_t);
+}
+
+/* Returns NULL once the frame the thread was bound to has been revoked */
+user_vector_state_t *lookupVectorState(tcb_t *thread)
+{
+    cte_t *slot = thread->tcbVectorState;
+
+    if (slot == NULL || cap_get_capType(slot->cap) != cap_frame_cap) {
+        return NULL;
+    }
+    return (user_vector_state_t *)cap_frame_cap_get_capFBasePtr(slot->cap);
+}
+
+void switchVectorOwner(tcb_t *new_owner)
+{
+    tcb_t *old_owner = NODE_STATE(ksActiveVectorOwner);
+    user_vector_state_t *state;
+
+    if (old_owner == new_owner) {
+        return;
+    }
+
+    if (old_owner != NULL) {
+        /* Threads that only read the vector registers don't need saving. If
+         * the frame was revoked the registers have nowhere to go, and the
+         * next vector instruction of the thread raises a user exception
+         * instead of running on another thread's registers. */
+        if (get_tcb_vs_state(old_owner) == SSTATUS_VS_DIRTY) {
+            state = lookupVectorState(old_owner);
+            if (state != NULL) {
+                saveVectorState(state);
+            }
+        }
+        set_tcb_vs_state(old_owner, 0);
+    }
+
+    if (new_owner != NULL) {
+        /* c_handle_vector_exception has checked the binding */
+        state = lookupVectorState(new_owner);
+        assert(state != NULL);
+        loadVectorState(state);
+        set_tcb_vs_state(new_owner, SSTATUS_VS_CLEAN);
+    }
+
+    NODE_STATE(ksActiveVectorOwner) = new_owner;
+}
+
+/* The first vector instruction of a thread that doesn't own the vector
+ * registers raises an illegal instruction exception with VS off */
+void handleVectorFault(void)
+{
+    switchVectorOwner(NODE_STATE(ksCurThread));
+}
+
+/* Drops the frame cap copy of the thread, its registers are not saved */
+static void vectorUnbind(tcb_t *thread)
+{
+    cte_t *slot = thread->tcbVectorState;
+
+    if (slot == NULL) {
+        return;
+    }
+
+    if (NODE_STATE(ksActiveVectorOwner) == thread) {
+        NODE_STATE(ksActiveVectorOwner) = NULL;
+    }
+    set_tcb_vs_state(thread, 0);
+    cteDeleteOne(slot);
+    VECTOR_BINDING_PTR(slot)->thread = NULL;
+    thread->tcbVectorState = NULL;
+}
+
+void vectorThreadDelete(tcb_t *thread)
+{
+    vectorUnbind(thread);
+}
+
+exception_t handle_SysSetVectorState(void)
+{
+    tcb_t *thread = NODE_STATE(ksCurThread);
+    cptr_t cptr = getRegister(thread, capRegister);
+    lookupCapAndSlot_ret_t lu_ret;
+    deriveCap_ret_t dc_ret;
+    vector_binding_t *binding = NULL;
+    word_t i;
+
+    if (cptr == 0) {
+        vectorUnbind(thread);
+        setRegister(thread, capRegister, seL4_NoError);
+        return EXCEPTION_NONE;
+    }
+
+    lu_ret = lookupCapAndSlot(thread, cptr);
+    if (unlikely(lu_ret.status != EXCEPTION_NONE || !isVectorFrame(lu_ret.cap))) {
+        userError("SysSetVectorState: vector state is not a large enough writable frame");
+        setRegister(thread, capRegister, seL4_InvalidCapability);
+        return EXCEPTION_NONE;
+    }
+
+    if (unlikely(read_vlenb() != CONFIG_RISCV_VLENB)) {
+        userError("SysSetVectorState: vlenb of the hart differs from the configured one");
+        setRegister(thread, capRegister, seL4_IllegalOperation);
+        return EXCEPTION_NONE;
+    }
+
+    if (thread->tcbVectorState != NULL) {
+        binding = VECTOR_BINDING_PTR(thread->tcbVectorState);
+    } else {
+        for (i = 0; i < CONFIG_RISCV_VECTOR_THREADS; i++) {
+            if (vectorBindings[i].thread == NULL) {
+                binding = &vectorBindings[i];
+                break;
+            }
+        }
+        if (unlikely(binding == NULL)) {
+            userError("SysSetVectorState: all vector state bindings are in use");
+            setRegister(thread, capRegister, seL4_NotEnoughMemory);
+            return EXCEPTION_NONE;
+        }
+    }
+
+    dc_ret = deriveCap(lu_ret.slot, &lu_ret.cap);
+    if (unlikely(dc_ret.status != EXCEPTION_NONE)) {
+        setRegister(thread, capRegister, seL4_InvalidCapability);
+        return EXCEPTION_NONE;
+    }
+
+    /* The registers go to the old frame, the new one takes effect on the
+     * next fault of the thread */
+    if (NODE_STATE(ksActiveVectorOwner) == thread) {
+        switchVectorOwner(NULL);
+    }
+    cteDeleteOne(&binding->slot);
+    cteInsert(&dc_ret.cap, lu_ret.slot, &binding->slot);
+    binding->thread = thread;
+    thread->tcbVectorState = &binding->slot;
+
+    setRegister(thread, capRegister, seL4_NoError);
+    return EXCEPTION_NONE;
+}
+
+#endif /* CONFIG_RISCV_EXT_V */
@@ -7,8 +7,100 @@
 
 #include <types.h>
 #include <api/failures.h>
+#include <api/syscall.h>
+#include <kernel/cspace.h>
+#include <model/statedata.h>
+#include <plat/machine.h>
 
 #include <arch/object/interrupt.h>
 
 exception_t Arch_invokeIRQControl(irq_t irq, cte_t *handlerSlot, cte_t *controlSlot, bool_t trigger);
 
+
+#ifdef CONFIG_IRQ_AFFINITY
+exception_t decodeIRQHandlerSetAffinity(cap_t cap, word_t length, word_t *buffer)
+{
+    irq_t irq = IDX_TO_IRQT(cap_irq_handler_cap_get_capIRQ(cap));
+    word_t core;
+
+    if (length < 1) {
+        userError("IRQHandler SetAffinity: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if (irq > PLIC_MAX_IRQ) {
+        userError("IRQHandler SetAffinity: IRQ %d is not a PLIC interrupt.", (int)irq);
+        current_syscall_error.type = seL4_IllegalOperation;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    core = getSyscallArg(0, buffer);
+    if (core >= ksNumCPUs) {
+        userError("IRQHandler SetAffinity: Requested CPU does not exist.");
+        current_syscall_error.type = seL4_InvalidArgument;
+        current_syscall_error.invalidArgumentNumber = 0;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    plic_irq_set_affinity(irq, cpuIndexToID(core));
+    return EXCEPTION_NONE;
+}
+
+/* The Ack of the Rust part of the kernel completes the claim in the PLIC
+ * context of the calling core, which the PLIC ignores for an IRQ routed to
+ * another core. Completes the claim of a routed IRQ in the context it is
+ * routed to, and returns false for the IRQs left to the Rust Ack. */
+bool_t ackRoutedIRQ(irq_t irq)
+{
+    if (irq > PLIC_MAX_IRQ || !plic_irq_is_routed(irq)) {
+        return false;
+    }
+
+    plic_complete_claim(irq);
+    return true;
+}
+
+/* The Rust part of the kernel doesn't know the affinity, so a routed IRQ
+ * would stay routed and enabled on its hart after its handler is deleted */
+void clearIRQAffinity(irq_t irq)
+{
+    if (irq <= PLIC_MAX_IRQ) {
+        plic_irq_clear_affinity(irq);
+    }
+}
+#endif /* CONFIG_IRQ_AFFINITY */
+
+#ifdef CONFIG_IRQ_PRIORITIES
+exception_t decodeIRQHandlerSetPriority(cap_t cap, word_t length, word_t *buffer)
+{
+    irq_t irq = IDX_TO_IRQT(cap_irq_handler_cap_get_capIRQ(cap));
+    word_t prio;
+
+    if (length < 1) {
+        userError("IRQHandler SetPriority: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if (irq > PLIC_MAX_IRQ) {
+        userError("IRQHandler SetPriority: IRQ %d is not a PLIC interrupt.", (int)irq);
+        current_syscall_error.type = seL4_IllegalOperation;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    /* As for threads, the caller can't hand out a priority above its MCP */
+    prio = getSyscallArg(0, buffer);
+    if (prio > NODE_STATE(ksCurThread)->tcbMCP) {
+        userError("IRQHandler SetPriority: Requested priority %lu too high (max %lu).",
+                  (unsigned long) prio, (unsigned long) NODE_STATE(ksCurThread)->tcbMCP);
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = seL4_MinPrio;
+        current_syscall_error.rangeErrorMax = NODE_STATE(ksCurThread)->tcbMCP;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    setIRQPriority(irq, prio);
+    return EXCEPTION_NONE;
+}
+#endif /* CONFIG_IRQ_PRIORITIES */
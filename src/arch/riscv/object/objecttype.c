@@ -12,6 +12,13 @@
 #include <arch/machine.h>
 #include <arch/model/statedata.h>
 #include <arch/object/objecttype.h>
+#include <arch/machine/vector.h>
+#ifdef CONFIG_WAKEUP_INBOX
+#include <object/tcb.h>
+#endif
+#ifdef CONFIG_ASYNC_EXECUTOR
+#include <api/executor.h>
+#endif
 
 deriveCap_ret_t Arch_deriveCap(cte_t *slot, cap_t cap)
 {
@@ -130,4 +137,13 @@ void Arch_prepareThreadDelete(tcb_t *thread)
 #ifdef CONFIG_HAVE_FPU
     fpuThreadDelete(thread);
 #endif
+#ifdef CONFIG_RISCV_EXT_V
+    vectorThreadDelete(thread);
+#endif
+#ifdef CONFIG_WAKEUP_INBOX
+    wakeupInboxRemove(thread);
+#endif
+#ifdef CONFIG_ASYNC_EXECUTOR
+    executorQueueRemove(thread);
+#endif
 }
@@ -8,12 +8,59 @@
 #include <mode/smp/ipi.h>
 #include <smp/lock.h>
 #include <util.h>
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+#include <arch/benchmark.h>
+#endif
 
 #ifdef ENABLE_SMP_SUPPORT
 
+static volatile irq_t            ipiIrq[CONFIG_MAX_NUM_NODES];
+
+#ifdef CONFIG_TARGETED_REMOTE_CALLS
+static void handleRemoteCallFunc(remote_call_t *call, bool_t irqPath)
+{
+    switch (call->func) {
+    case IpiRemoteCall_Stall:
+        ipiStallCoreCallback(irqPath);
+        break;
+
+#ifdef CONFIG_HAVE_FPU
+    case IpiRemoteCall_switchFpuOwner:
+        switchLocalFpuOwner((user_fpu_state_t *)call->args[0]);
+        break;
+#endif /* CONFIG_HAVE_FPU */
+
+    default:
+        fail("Invalid remote call");
+        break;
+    }
+}
+
+void handleRemoteCalls(bool_t irqPath)
+{
+    word_t cpu = getCurrentCPUIndex();
+    remote_call_queue_t *queue = &remoteCallQueue[cpu];
+
+    /* we gets spurious irq_remote_call_ipi calls, e.g. when handling IPI
+     * in lock while hardware IPI is pending. Guard against spurious IPIs! */
+    if (!remote_calls_pending(cpu)) {
+        return;
+    }
+
+    /* Calls posted after the flag is cleared send a new IPI, and calls posted
+     * before are seen below */
+    ipiIrq[cpu] = irqInvalid;
+    big_kernel_lock.node_owners[cpu].ipi = 0;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    while (remote_calls_pending(cpu)) {
+        handleRemoteCallFunc(&queue->calls[queue->head % REMOTE_CALL_QUEUE_LENGTH], irqPath);
+        remote_call_complete(cpu);
+    }
+}
+#else
 /* the remote call being requested */
 static volatile IpiRemoteCall_t  remoteCall;
-static volatile irq_t            ipiIrq[CONFIG_MAX_NUM_NODES];
 
 static inline void init_ipi_args(IpiRemoteCall_t func,
                                  word_t data1, word_t data2, word_t data3,
@@ -55,6 +102,7 @@ static void handleRemoteCall(IpiRemoteCall_t call, word_t arg0,
         ipi_wait(totalCoreBarrier);
     }
 }
+#endif /* CONFIG_TARGETED_REMOTE_CALLS */
 
 void ipi_send_mask(irq_t ipi, word_t mask, bool_t isBlocking)
 {
@@ -82,11 +130,25 @@ void ipi_send_target(irq_t irq, word_t hart_id)
     assert(core_id < CONFIG_MAX_NUM_NODES);
 
     assert((ipiIrq[core_id] == irqInvalid) || (ipiIrq[core_id] == irq_reschedule_ipi) ||
+#ifdef CONFIG_ASYNC_EXECUTOR
+           (ipiIrq[core_id] == irq_async_syscall_ipi) ||
+#endif
+#ifdef CONFIG_TARGETED_REMOTE_CALLS
+           /* the reschedule IPI handles pending remote calls as well */
+           (ipiIrq[core_id] == irq_remote_call_ipi) ||
+#endif
            (ipiIrq[core_id] == irq_remote_call_ipi && big_kernel_lock.node_owners[core_id].ipi == 0));
 
     ipiIrq[core_id] = irq;
     fence_rw_rw();
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    timestamp_t start = timestamp();
+#endif
     sbi_send_ipi(hart_mask);
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    NODE_STATE(benchmark_ipi_send_cycles) += timestamp() - start;
+    NODE_STATE(benchmark_ipi_sends)++;
+#endif
 }
 
 #endif
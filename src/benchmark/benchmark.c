@@ -12,6 +12,9 @@
 #include <mode/machine.h>
 #include <benchmark/benchmark.h>
 #include <benchmark/benchmark_utilisation.h>
+#if defined(CONFIG_BENCHMARK_GENERIC) && defined(ENABLE_SMP_SUPPORT)
+#include <smp/lock.h>
+#endif
 
 
 exception_t handle_SysBenchmarkFlushCaches(void)
@@ -51,9 +54,61 @@ exception_t handle_SysBenchmarkResetLog(void)
     NODE_STATE(benchmark_kernel_time) = 0;
     NODE_STATE(benchmark_kernel_number_entries) = 0;
     NODE_STATE(benchmark_kernel_number_schedules) = 1;
+#ifdef CONFIG_CROSSCORE_FASTPATH
+    NODE_STATE(benchmark_crosscore_fastpath) = 0;
+    NODE_STATE(benchmark_crosscore_fastpath_cycles) = 0;
+#endif
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+    NODE_STATE(benchmark_cap_cache_hits) = 0;
+    NODE_STATE(benchmark_cap_cache_misses) = 0;
+#endif
+#ifdef CONFIG_BATCH_INVOCATION
+    NODE_STATE(benchmark_batch_invocations) = 0;
+    NODE_STATE(benchmark_batch_cycles) = 0;
+#endif
+#ifdef CONFIG_ASYNC_EXECUTOR
+    NODE_STATE(benchmark_async_invocations) = 0;
+    NODE_STATE(benchmark_async_completions) = 0;
+    NODE_STATE(benchmark_async_cycles) = 0;
+#endif
+#ifdef CONFIG_RELEASE_SLACK
+    NODE_STATE(benchmark_coalesced_releases) = 0;
+#endif
+#ifdef CONFIG_WORK_STEALING
+    NODE_STATE(benchmark_steals) = 0;
+    NODE_STATE(benchmark_migrations) = 0;
+#endif
+#ifdef CONFIG_WAKEUP_INBOX
+    NODE_STATE(benchmark_inbox_wakeups) = 0;
+#endif
+#ifdef CONFIG_TARGETED_REMOTE_CALLS
+    NODE_STATE(benchmark_remote_calls) = 0;
+#endif
+#ifdef CONFIG_ARCH_RISCV
+    NODE_STATE(benchmark_timer_programs) = 0;
+    NODE_STATE(benchmark_timer_program_cycles) = 0;
+    NODE_STATE(benchmark_ipi_sends) = 0;
+    NODE_STATE(benchmark_ipi_send_cycles) = 0;
+    NODE_STATE(benchmark_timer_irqs) = 0;
+    NODE_STATE(benchmark_timer_irq_cycles) = 0;
+    NODE_STATE(benchmark_trap_entries) = 0;
+    NODE_STATE(benchmark_trap_entry_cycles) = 0;
+    NODE_STATE(benchmark_ipc_trap_entries) = 0;
+    NODE_STATE(benchmark_ipc_trap_entry_cycles) = 0;
+#endif
+#ifdef CONFIG_RISCV_IRQ_BATCH
+    NODE_STATE(benchmark_irq_batch_entries) = 0;
+    NODE_STATE(benchmark_irq_batch_irqs) = 0;
+#endif
     benchmark_arch_utilisation_reset();
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
 
+#if defined(CONFIG_BENCHMARK_GENERIC) && defined(ENABLE_SMP_SUPPORT)
+    for (word_t i = 0; i < BENCHMARK_LOCK_NUM_VALUES; i++) {
+        ksLockStats[CURRENT_CPU_INDEX()].values[i] = 0;
+    }
+#endif
+
     setRegister(NODE_STATE(ksCurThread), capRegister, seL4_NoError);
     return EXCEPTION_NONE;
 }
@@ -69,6 +124,16 @@ exception_t handle_SysBenchmarkFinalizeLog(void)
     benchmark_utilisation_finalise();
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
 
+#if defined(CONFIG_BENCHMARK_GENERIC) && defined(ENABLE_SMP_SUPPORT)
+    word_t *buffer = lookupIPCBuffer(true, NODE_STATE(ksCurThread));
+    if (buffer != NULL) {
+        uint64_t *values = (uint64_t *) & (((seL4_IPCBuffer *)buffer)->msg[0]);
+        for (word_t i = 0; i < BENCHMARK_LOCK_NUM_VALUES; i++) {
+            values[i] = ksLockStats[CURRENT_CPU_INDEX()].values[i];
+        }
+    }
+#endif
+
     return EXCEPTION_NONE;
 }
 
@@ -64,6 +64,52 @@ void benchmark_track_utilisation_dump(void)
     buffer[BENCHMARK_TOTAL_NUMBER_SCHEDULES] = NODE_STATE(benchmark_kernel_number_schedules);
     buffer[BENCHMARK_TOTAL_KERNEL_UTILISATION] = NODE_STATE(benchmark_kernel_time);
     buffer[BENCHMARK_TOTAL_NUMBER_KERNEL_ENTRIES] = NODE_STATE(benchmark_kernel_number_entries);
+#ifdef CONFIG_CROSSCORE_FASTPATH
+    buffer[BENCHMARK_TOTAL_CROSSCORE_FASTPATH] = NODE_STATE(benchmark_crosscore_fastpath);
+    buffer[BENCHMARK_TOTAL_CROSSCORE_FASTPATH_CYCLES] = NODE_STATE(benchmark_crosscore_fastpath_cycles);
+#endif
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+    buffer[BENCHMARK_TOTAL_CAP_CACHE_HITS] = NODE_STATE(benchmark_cap_cache_hits);
+    buffer[BENCHMARK_TOTAL_CAP_CACHE_MISSES] = NODE_STATE(benchmark_cap_cache_misses);
+#endif
+#ifdef CONFIG_BATCH_INVOCATION
+    buffer[BENCHMARK_TOTAL_BATCH_INVOCATIONS] = NODE_STATE(benchmark_batch_invocations);
+    buffer[BENCHMARK_TOTAL_BATCH_CYCLES] = NODE_STATE(benchmark_batch_cycles);
+#endif
+#ifdef CONFIG_ASYNC_EXECUTOR
+    buffer[BENCHMARK_TOTAL_ASYNC_INVOCATIONS] = NODE_STATE(benchmark_async_invocations);
+    buffer[BENCHMARK_TOTAL_ASYNC_COMPLETIONS] = NODE_STATE(benchmark_async_completions);
+    buffer[BENCHMARK_TOTAL_ASYNC_CYCLES] = NODE_STATE(benchmark_async_cycles);
+#endif
+#ifdef CONFIG_RELEASE_SLACK
+    buffer[BENCHMARK_TOTAL_COALESCED_RELEASES] = NODE_STATE(benchmark_coalesced_releases);
+#endif
+#ifdef CONFIG_WORK_STEALING
+    buffer[BENCHMARK_TOTAL_STEALS] = NODE_STATE(benchmark_steals);
+    buffer[BENCHMARK_TOTAL_MIGRATIONS] = NODE_STATE(benchmark_migrations);
+#endif
+#ifdef CONFIG_WAKEUP_INBOX
+    buffer[BENCHMARK_TOTAL_INBOX_WAKEUPS] = NODE_STATE(benchmark_inbox_wakeups);
+#endif
+#ifdef CONFIG_TARGETED_REMOTE_CALLS
+    buffer[BENCHMARK_TOTAL_REMOTE_CALLS] = NODE_STATE(benchmark_remote_calls);
+#endif
+#ifdef CONFIG_ARCH_RISCV
+    buffer[BENCHMARK_TOTAL_TIMER_PROGRAMS] = NODE_STATE(benchmark_timer_programs);
+    buffer[BENCHMARK_TOTAL_TIMER_PROGRAM_CYCLES] = NODE_STATE(benchmark_timer_program_cycles);
+    buffer[BENCHMARK_TOTAL_IPI_SENDS] = NODE_STATE(benchmark_ipi_sends);
+    buffer[BENCHMARK_TOTAL_IPI_SEND_CYCLES] = NODE_STATE(benchmark_ipi_send_cycles);
+    buffer[BENCHMARK_TOTAL_TIMER_IRQS] = NODE_STATE(benchmark_timer_irqs);
+    buffer[BENCHMARK_TOTAL_TIMER_IRQ_CYCLES] = NODE_STATE(benchmark_timer_irq_cycles);
+    buffer[BENCHMARK_TOTAL_TRAP_ENTRIES] = NODE_STATE(benchmark_trap_entries);
+    buffer[BENCHMARK_TOTAL_TRAP_ENTRY_CYCLES] = NODE_STATE(benchmark_trap_entry_cycles);
+    buffer[BENCHMARK_TOTAL_IPC_TRAP_ENTRIES] = NODE_STATE(benchmark_ipc_trap_entries);
+    buffer[BENCHMARK_TOTAL_IPC_TRAP_ENTRY_CYCLES] = NODE_STATE(benchmark_ipc_trap_entry_cycles);
+#endif
+#ifdef CONFIG_RISCV_IRQ_BATCH
+    buffer[BENCHMARK_TOTAL_IRQ_BATCH_ENTRIES] = NODE_STATE(benchmark_irq_batch_entries);
+    buffer[BENCHMARK_TOTAL_IRQ_BATCH_IRQS] = NODE_STATE(benchmark_irq_batch_irqs);
+#endif
 
 }
 
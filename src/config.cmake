@@ -15,6 +15,8 @@ add_sources(
         src/fastpath/fastpath.c
         src/api/syscall.c
         src/api/faults.c
+        src/api/batch.c
+        src/api/executor.c
         src/kernel/cspace.c
         src/kernel/faulthandler.c
         src/kernel/thread.c
@@ -12,6 +12,33 @@
 #endif
 #include <benchmark/benchmark_utilisation.h>
 
+#ifdef CONFIG_FINE_GRAINED_LOCKING
+/* The send and wait fastpaths may run under the shared lock rather than
+ * big_kernel_lock, see the lock order in smp/lock.h */
+static inline void fastpath_unlock(void)
+{
+#ifdef CONFIG_BENCHMARK_GENERIC
+    if (shared_lock_is_held()) {
+        ksLockStats[getCurrentCPUIndex()].values[BENCHMARK_LOCK_SHARED_FASTPATHS]++;
+    }
+#endif
+    shared_lock_release();
+}
+
+static inline void NORETURN fastpath_locked_slowpath(syscall_t syscall)
+{
+    shared_lock_upgrade();
+    slowpath(syscall);
+}
+
+#define FASTPATH_OBJECT_LOCK(_object) object_lock_acquire(_object)
+#define FASTPATH_UNLOCK fastpath_unlock()
+#else
+#define fastpath_locked_slowpath(_syscall) slowpath(_syscall)
+#define FASTPATH_OBJECT_LOCK(_object) do {} while (0)
+#define FASTPATH_UNLOCK do {} while (0)
+#endif
+
 #ifdef CONFIG_ARCH_ARM
 static inline
 FORCE_INLINE
@@ -27,11 +54,8 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo);
 
 
 #ifdef CONFIG_SIGNAL_FASTPATH
-#ifdef CONFIG_ARCH_ARM
-static inline
-FORCE_INLINE
-#endif
-void NORETURN fastpath_signal(word_t cptr, word_t msgInfo)
+/* Signal on a cap already looked up by the caller */
+static inline FORCE_INLINE void NORETURN fastpath_signal_cap(cap_t cap)
 {
     word_t fault_type;
     sched_context_t *sc = NULL;
@@ -49,9 +73,6 @@ void NORETURN fastpath_signal(word_t cptr, word_t msgInfo)
         slowpath(SysSend);
     }
 
-    /* Lookup the cap */
-    cap_t cap = lookup_fp(TCB_PTR_CTE_PTR(NODE_STATE(ksCurThread), tcbCTable)->cap, cptr);
-
     /* Check it's a notification */
     if (unlikely(!cap_capType_equals(cap, cap_notification_cap))) {
         slowpath(SysSend);
@@ -125,7 +146,12 @@ void NORETURN fastpath_signal(word_t cptr, word_t msgInfo)
 
     /* Only fastpath signal to threads which will not become the new highest prio thread on the
      * core of their SC, even if the currently running thread on the core is the idle thread. */
-    if (NODE_STATE_ON_CORE(ksCurThread, sc->scCore)->tcbPriority < dest->tcbPriority) {
+    if (NODE_STATE_ON_CORE(ksCurThread, sc->scCore)->tcbPriority < dest->tcbPriority
+#ifdef CONFIG_CROSSCORE_FASTPATH
+        /* Another core is told to reschedule with an IPI instead */
+        && sc->scCore == getCurrentCPUIndex()
+#endif
+       ) {
         slowpath(SysSend);
     }
 
@@ -186,14 +212,337 @@ void NORETURN fastpath_signal(word_t cptr, word_t msgInfo)
         }
     }
 
+#ifdef CONFIG_CROSSCORE_FASTPATH
+    if (sc->scCore != getCurrentCPUIndex()) {
+        fastpath_remote_reschedule();
+    }
+#endif
+
+    restore_user_context();
+}
+
+#ifdef CONFIG_ARCH_ARM
+static inline
+FORCE_INLINE
+#endif
+void NORETURN fastpath_signal(word_t cptr, word_t msgInfo)
+{
+    /* Lookup the cap */
+    cap_t cap = lookup_fp(TCB_PTR_CTE_PTR(NODE_STATE(ksCurThread), tcbCTable)->cap, cptr);
+
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+    fastpath_cap_cache_check_invocation(cap);
+#endif
+
+    fastpath_signal_cap(cap);
+}
+#endif
+
+#ifdef CONFIG_WAIT_FASTPATH
+void NORETURN fastpath_wait(word_t cptr, word_t msgInfo, syscall_t syscall)
+{
+    word_t fault_type;
+    bool_t blocking;
+    tcb_t *boundTCB;
+
+    /* Get fault type. */
+    fault_type = seL4_Fault_get_seL4_FaultType(NODE_STATE(ksCurThread)->tcbFault);
+
+    /* Check there's no saved fault. Can be removed if the current thread can't
+     * have a fault while invoking the fastpath */
+    if (unlikely(fault_type != seL4_Fault_NullFault)) {
+        fastpath_locked_slowpath(syscall);
+    }
+
+    /* Lookup the cap */
+    cap_t cap = lookup_fp(TCB_PTR_CTE_PTR(NODE_STATE(ksCurThread), tcbCTable)->cap, cptr);
+
+    /* Check it's a notification, receives on endpoints are left to the slowpath */
+    if (unlikely(!cap_capType_equals(cap, cap_notification_cap))) {
+        fastpath_locked_slowpath(syscall);
+    }
+
+    /* Check that we are allowed to receive on this cap */
+    if (unlikely(!cap_notification_cap_get_capNtfnCanReceive(cap))) {
+        fastpath_locked_slowpath(syscall);
+    }
+
+    /* Get the notification address */
+    notification_t *ntfnPtr = NTFN_PTR(cap_notification_cap_get_capNtfnPtr(cap));
+    FASTPATH_OBJECT_LOCK(ntfnPtr);
+
+    /* A notification bound to another thread raises a fault on the slowpath */
+    boundTCB = TCB_PTR(notification_ptr_get_ntfnBoundTCB(ntfnPtr));
+    if (unlikely(boundTCB != NULL && boundTCB != NODE_STATE(ksCurThread))) {
+        fastpath_locked_slowpath(syscall);
+    }
+
+#ifdef CONFIG_KERNEL_MCS
+    /* Check that the current domain hasn't expired */
+    if (unlikely(isCurDomainExpired())) {
+        fastpath_locked_slowpath(syscall);
+    }
+
+    /* An SC donated through a ReplyRecv may need refill_unblock_check */
+    if (unlikely(NODE_STATE(ksCurThread)->tcbSchedContext != NODE_STATE(ksCurSC))) {
+        fastpath_locked_slowpath(syscall);
+    }
+
+    blocking = syscall == SysRecv || syscall == SysWait;
+#else
+    blocking = syscall == SysRecv;
+#endif
+
+    switch (notification_ptr_get_state(ntfnPtr)) {
+    case NtfnState_Active:
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
+        ksKernelEntry.is_fastpath = true;
+#endif
+        /* Take the badge and clear the word, as receiveSignal does */
+        setRegister(NODE_STATE(ksCurThread), badgeRegister,
+                    notification_ptr_get_ntfnMsgIdentifier(ntfnPtr));
+        notification_ptr_set_state(ntfnPtr, NtfnState_Idle);
+        FASTPATH_UNLOCK;
+        restore_user_context();
+        UNREACHABLE();
+    default:
+        /* Blocking has to go through the slowpath and schedule() */
+        if (blocking) {
+            fastpath_locked_slowpath(syscall);
+        }
+
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
+        ksKernelEntry.is_fastpath = true;
+#endif
+        /* Equivalent to doNBRecvFailedTransfer */
+        setRegister(NODE_STATE(ksCurThread), badgeRegister, 0);
+        FASTPATH_UNLOCK;
+        restore_user_context();
+        UNREACHABLE();
+    }
+}
+#endif
+
+#ifdef CONFIG_SEND_FASTPATH
+void NORETURN fastpath_send(word_t cptr, word_t msgInfo, syscall_t syscall)
+{
+    seL4_MessageInfo_t info;
+    cap_t ep_cap;
+    endpoint_t *ep_ptr;
+    word_t length;
+    tcb_t *dest;
+    word_t badge;
+    word_t fault_type;
+#ifndef CONFIG_KERNEL_MCS
+    cap_t newVTable;
+    vspace_root_t *cap_pd;
+    pte_t stored_hw_asid;
+#endif
+
+    /* Get message info, length, and fault type. */
+    info = messageInfoFromWord_raw(msgInfo);
+    length = seL4_MessageInfo_get_length(info);
+    fault_type = seL4_Fault_get_seL4_FaultType(NODE_STATE(ksCurThread)->tcbFault);
+
+    /* Lookup the cap. This is done before any check that can leave for the
+     * slowpath, so the cap cache sees every invocation. */
+    ep_cap = lookup_fp(TCB_PTR_CTE_PTR(NODE_STATE(ksCurThread), tcbCTable)->cap, cptr);
+
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+    fastpath_cap_cache_check_invocation(ep_cap);
+#endif
+
+    /* Check there's no extra caps, the length is ok and there's no
+     * saved fault. */
+    if (unlikely(fastpath_send_mi_check(msgInfo) ||
+                 fault_type != seL4_Fault_NullFault)) {
+        fastpath_locked_slowpath(syscall);
+    }
+
+#ifdef CONFIG_SIGNAL_FASTPATH
+    /* seL4_Signal is a send on a notification cap */
+    if (cap_capType_equals(ep_cap, cap_notification_cap) && syscall == SysSend) {
+        fastpath_signal_cap(ep_cap);
+    }
+#endif
+
+    /* Check it's an endpoint we are allowed to send to */
+    if (unlikely(!cap_capType_equals(ep_cap, cap_endpoint_cap) ||
+                 !cap_endpoint_cap_get_capCanSend(ep_cap))) {
+        fastpath_locked_slowpath(syscall);
+    }
+
+    /* Get the endpoint address */
+    ep_ptr = EP_PTR(cap_endpoint_cap_get_capEPPtr(ep_cap));
+    FASTPATH_OBJECT_LOCK(ep_ptr);
+
+    /* Get the destination thread, which is only going to be valid
+     * if the endpoint is valid. */
+    dest = TCB_PTR(endpoint_ptr_get_epQueue_head(ep_ptr));
+
+    /* Check that there's a thread waiting to receive */
+    if (unlikely(endpoint_ptr_get_state(ep_ptr) != EPState_Recv)) {
+        fastpath_locked_slowpath(syscall);
+    }
+
+#ifndef CONFIG_KERNEL_MCS
+    /* Get destination thread.*/
+    newVTable = TCB_PTR_CTE_PTR(dest, tcbVTable)->cap;
+
+    /* Get vspace root. */
+    cap_pd = cap_vtable_cap_get_vspace_root_fp(newVTable);
+
+    /* Ensure that the destination has a valid VTable, in case we switch to it. */
+    if (unlikely(! isValidVTableRoot_fp(&newVTable))) {
+        fastpath_locked_slowpath(syscall);
+    }
+
+    stored_hw_asid.words[0] = cap_page_table_cap_get_capPTMappedASID(newVTable);
+#endif
+
+    /* Ensure the receiver is in the current domain and can be scheduled directly. */
+    if (unlikely(dest->tcbDomain != ksCurDomain && 0 < maxDom)) {
+        fastpath_locked_slowpath(syscall);
+    }
+
+#ifdef ENABLE_SMP_SUPPORT
+    /* Ensure both threads have the same affinity */
+    if (unlikely(NODE_STATE(ksCurThread)->tcbAffinity != dest->tcbAffinity)) {
+        fastpath_locked_slowpath(syscall);
+    }
+#endif /* ENABLE_SMP_SUPPORT */
+
+#ifdef CONFIG_RISCV_FAST_MESSAGE_REGISTERS
+    /* Message registers past n_msgRegisters are delivered in the IPC buffer */
+    word_t *dest_buf = NULL;
+    if (length > n_msgRegisters) {
+        dest_buf = lookupIPCBuffer(true, dest);
+        if (unlikely(dest_buf == NULL)) {
+            fastpath_locked_slowpath(syscall);
+        }
+    }
+#endif
+
+#ifdef CONFIG_KERNEL_MCS
+    /* Check that the current domain hasn't expired */
+    if (unlikely(isCurDomainExpired())) {
+        fastpath_locked_slowpath(syscall);
+    }
+
+    /* A send never donates, so the receiver has to run on its own SC. Passive
+     * receivers and receivers that need the budget logic of schedContext_resume
+     * are left to the slowpath. */
+    sched_context_t *sc = dest->tcbSchedContext;
+    if (unlikely(sc == NULL || sc->scRefillMax == 0 ||
+                 !(refill_ready(sc) && refill_sufficient(sc, 0)))) {
+        fastpath_locked_slowpath(syscall);
+    }
+
+    /* Switching SC requires committing the consumed time and reprogramming
+     * the timer, so only fastpath receivers that will not preempt us. */
+    if (unlikely(dest->tcbPriority > NODE_STATE(ksCurThread)->tcbPriority)) {
+        fastpath_locked_slowpath(syscall);
+    }
+#endif
+
+    /*
+     * --- POINT OF NO RETURN ---
+     *
+     * At this stage, we have committed to performing the IPC.
+     */
+
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
+    ksKernelEntry.is_fastpath = true;
+#endif
+
+    /* Dequeue the destination. */
+    endpoint_ptr_set_epQueue_head_np(ep_ptr, TCB_REF(dest->tcbEPNext));
+    if (unlikely(dest->tcbEPNext)) {
+        dest->tcbEPNext->tcbEPPrev = NULL;
+    } else {
+        endpoint_ptr_mset_epQueue_tail_state(ep_ptr, 0, EPState_Idle);
+    }
+
+    badge = cap_endpoint_cap_get_capEPBadge(ep_cap);
+
+#ifdef CONFIG_KERNEL_MCS
+    /* Equivalent to reply_unlink without the state change, the receiver is
+     * set running below */
+    reply_t *reply = thread_state_get_replyObject_np(dest->tcbState);
+    if (reply != NULL) {
+        thread_state_ptr_set_replyObject_np(&dest->tcbState, 0);
+        reply->replyTCB = NULL;
+    }
+
+    /* As in sendIPC, the head refill of a sporadic receiver starts now */
+    if (sc_sporadic(sc)) {
+        assert(sc != NODE_STATE(ksCurSC));
+        refill_unblock_check(sc);
+    }
+#endif
+
+    /* Copy the message and wake up the receiver */
+#ifdef CONFIG_RISCV_FAST_MESSAGE_REGISTERS
+    if (length > n_msgRegisters) {
+        fastpath_copy_mrs(n_msgRegisters, NODE_STATE(ksCurThread), dest);
+        fastpath_copy_fast_mrs(length, NODE_STATE(ksCurThread), dest_buf);
+    } else {
+        fastpath_copy_mrs(length, NODE_STATE(ksCurThread), dest);
+    }
+#else
+    fastpath_copy_mrs(length, NODE_STATE(ksCurThread), dest);
+#endif
+    msgInfo = wordFromMessageInfo(seL4_MessageInfo_set_capsUnwrapped(info, 0));
+    setRegister(dest, badgeRegister, badge);
+    setRegister(dest, msgInfoRegister, msgInfo);
+    thread_state_ptr_set_tsType_np(&dest->tcbState, ThreadState_Running);
+
+#ifndef CONFIG_KERNEL_MCS
+    /* The sender stays runnable, so if the receiver would preempt it we switch
+     * directly and put the sender at the head of its ready queue, as schedule()
+     * would. */
+    if (dest->tcbPriority > NODE_STATE(ksCurThread)->tcbPriority) {
+        SCHED_ENQUEUE_CURRENT_TCB;
+        switchToThread_fp(dest, cap_pd, stored_hw_asid);
+        FASTPATH_UNLOCK;
+        fastpath_restore(badge, msgInfo, NODE_STATE(ksCurThread));
+    }
+#endif
+
+    /* Same queue placement as possibleSwitchTo followed by schedule() */
+    if (NODE_STATE(ksCurThread)->tcbPriority > dest->tcbPriority) {
+        SCHED_ENQUEUE(dest);
+    } else {
+        SCHED_APPEND(dest);
+    }
+
+    FASTPATH_UNLOCK;
     restore_user_context();
 }
 #endif
 
 #ifdef CONFIG_EXCEPTION_FASTPATH
+/* The exception fastpaths share their checks and the IPC to the fault handler
+ * and only differ in how the fault is recorded and which slowpath they take.
+ * fault_type is a compile-time constant at every call site, so the switches
+ * below are folded away. */
 static inline
 FORCE_INLINE
-void NORETURN fastpath_vm_fault(vm_fault_type_t type)
+void NORETURN fastpath_fault_slowpath(word_t fault_type, word_t arg)
+{
+    switch (fault_type) {
+    case seL4_Fault_VMFault:
+        vm_fault_slowpath(arg);
+    case seL4_Fault_UnknownSyscall:
+        slowpath(arg);
+    default:
+        user_exception_slowpath();
+    }
+}
+
+static inline
+FORCE_INLINE
+void NORETURN fastpath_fault(word_t fault_type, word_t arg)
 {
     cap_t handler_cap;
     endpoint_t *ep_ptr;
@@ -205,6 +554,9 @@ void NORETURN fastpath_vm_fault(vm_fault_type_t type)
     word_t msgInfo;
     pde_t stored_hw_asid;
     dom_t dom;
+#ifdef CONFIG_KERNEL_MCS
+    bool_t enqueue_dest = false;
+#endif
 
     /* Get the fault handler endpoint */
 #ifdef CONFIG_KERNEL_MCS
@@ -222,7 +574,7 @@ void NORETURN fastpath_vm_fault(vm_fault_type_t type)
                                                                       !cap_endpoint_cap_get_capCanGrantReply(handler_cap))
 #endif
                 )) {
-        vm_fault_slowpath(type);
+        fastpath_fault_slowpath(fault_type, arg);
     }
 
     /* Get the endpoint address */
@@ -234,7 +586,7 @@ void NORETURN fastpath_vm_fault(vm_fault_type_t type)
 
     /* Check that there's a thread waiting to receive */
     if (unlikely(endpoint_ptr_get_state(ep_ptr) != EPState_Recv)) {
-        vm_fault_slowpath(type);
+        fastpath_fault_slowpath(fault_type, arg);
     }
 
     /* Get destination thread.*/
@@ -245,7 +597,7 @@ void NORETURN fastpath_vm_fault(vm_fault_type_t type)
 
     /* Ensure that the destination has a valid VTable. */
     if (unlikely(! isValidVTableRoot_fp((cap_t*)&newVTable))) {
-        vm_fault_slowpath(type);
+        fastpath_fault_slowpath(fault_type, arg);
     }
 
 #ifdef CONFIG_ARCH_AARCH64
@@ -254,12 +606,12 @@ void NORETURN fastpath_vm_fault(vm_fault_type_t type)
     asid_map_t asid_map = findMapForASID(asid);
     if (unlikely(asid_map_get_type(asid_map) != asid_map_asid_map_vspace ||
                  VSPACE_PTR(asid_map_asid_map_vspace_get_vspace_root(asid_map)) != cap_pd)) {
-        vm_fault_slowpath(type);
+        fastpath_fault_slowpath(fault_type, arg);
     }
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
     /* Ensure the vmid is valid. */
     if (unlikely(!asid_map_asid_map_vspace_get_stored_vmid_valid(asid_map))) {
-        vm_fault_slowpath(type);
+        fastpath_fault_slowpath(fault_type, arg);
     }
 
     /* vmids are the tags used instead of hw_asids in hyp mode */
@@ -267,6 +619,8 @@ void NORETURN fastpath_vm_fault(vm_fault_type_t type)
 #else
     stored_hw_asid.words[0] = asid;
 #endif
+#else
+    stored_hw_asid.words[0] = cap_page_table_cap_get_capPTMappedASID(newVTable);
 #endif
 
     /* let gcc optimise this out for 1 domain */
@@ -274,30 +628,55 @@ void NORETURN fastpath_vm_fault(vm_fault_type_t type)
     /* ensure only the idle thread or lower prio threads are present in the scheduler */
     if (unlikely(dest->tcbPriority < NODE_STATE(ksCurThread->tcbPriority) &&
                  !isHighestPrio(dom, dest->tcbPriority))) {
-
-        vm_fault_slowpath(type);
+#ifdef CONFIG_KERNEL_MCS
+        /* A handler with its own SC can be enqueued instead, a passive one
+         * would need the donation undone by the slowpath */
+        if (dest->tcbSchedContext == NULL) {
+            fastpath_fault_slowpath(fault_type, arg);
+        }
+        enqueue_dest = true;
+#else
+        fastpath_fault_slowpath(fault_type, arg);
+#endif
     }
 
     /* Ensure the original caller is in the current domain and can be scheduled directly. */
     if (unlikely(dest->tcbDomain != ksCurDomain && 0 < maxDom)) {
-        vm_fault_slowpath(type);
+        fastpath_fault_slowpath(fault_type, arg);
     }
 
 #ifdef CONFIG_KERNEL_MCS
-    if (unlikely(dest->tcbSchedContext != NULL)) {
-        vm_fault_slowpath(type);
-    }
-
     reply_t *reply = thread_state_get_replyObject_np(dest->tcbState);
     if (unlikely(reply == NULL)) {
-        vm_fault_slowpath(type);
+        fastpath_fault_slowpath(fault_type, arg);
+    }
+
+    /* An active handler keeps its own SC and the faulting thread keeps its
+     * SC, so running the handler means switching SC. Leave the cases where
+     * either SC is out of budget to the slowpath. */
+    sched_context_t *dest_sc = dest->tcbSchedContext;
+    if (dest_sc != NULL) {
+        if (unlikely(isCurDomainExpired())) {
+            fastpath_fault_slowpath(fault_type, arg);
+        }
+
+        if (unlikely(dest_sc->scRefillMax == 0 || !(refill_ready(dest_sc) && refill_sufficient(dest_sc, 0)))) {
+            fastpath_fault_slowpath(fault_type, arg);
+        }
+
+        /* The time consumed so far is charged to the faulting thread when
+         * switching SC, so it must still be within budget */
+        updateTimestamp();
+        if (unlikely(!refill_sufficient(NODE_STATE(ksCurSC), NODE_STATE(ksConsumed)))) {
+            fastpath_fault_slowpath(fault_type, arg);
+        }
     }
 #endif
 
 #ifdef ENABLE_SMP_SUPPORT
     /* Ensure both threads have the same affinity */
     if (unlikely(NODE_STATE(ksCurThread)->tcbAffinity != dest->tcbAffinity)) {
-        vm_fault_slowpath(type);
+        fastpath_fault_slowpath(fault_type, arg);
     }
 #endif /* ENABLE_SMP_SUPPORT */
 
@@ -307,10 +686,20 @@ void NORETURN fastpath_vm_fault(vm_fault_type_t type)
      * At this stage, we have committed to performing the IPC.
      */
 
-    /* Sets the tcb fault based on the vm fault information. Has one slowpath transition
-    but only for a debug fault on AARCH32 */
-
-    fastpath_set_tcbfault_vm_fault(type);
+    /* Record the fault in the faulting thread, as handleFault would from
+     * current_fault. The vm fault has one slowpath transition but only for a
+     * debug fault on AARCH32 */
+    switch (fault_type) {
+    case seL4_Fault_VMFault:
+        fastpath_set_tcbfault_vm_fault(arg);
+        break;
+    case seL4_Fault_UnknownSyscall:
+        NODE_STATE(ksCurThread)->tcbFault = seL4_Fault_UnknownSyscall_new(arg);
+        break;
+    default:
+        NODE_STATE(ksCurThread)->tcbFault = seL4_Fault_UserException_new(arg, 0);
+        break;
+    }
 
 #ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
     ksKernelEntry.is_fastpath = true;
@@ -334,18 +723,24 @@ void NORETURN fastpath_vm_fault(vm_fault_type_t type)
     thread_state_ptr_set_replyObject_np(&NODE_STATE(ksCurThread)->tcbState, REPLY_REF(reply));
     reply->replyTCB = NODE_STATE(ksCurThread);
 
-    sched_context_t *sc = NODE_STATE(ksCurThread)->tcbSchedContext;
-    sc->scTcb = dest;
-    dest->tcbSchedContext = sc;
-    NODE_STATE(ksCurThread)->tcbSchedContext = NULL;
+    if (dest_sc == NULL) {
+        sched_context_t *sc = NODE_STATE(ksCurThread)->tcbSchedContext;
+        sc->scTcb = dest;
+        dest->tcbSchedContext = sc;
+        NODE_STATE(ksCurThread)->tcbSchedContext = NULL;
 
-    reply_t *old_caller = sc->scReply;
-    reply->replyPrev = call_stack_new(REPLY_REF(sc->scReply), false);
-    if (unlikely(old_caller)) {
-        old_caller->replyNext = call_stack_new(REPLY_REF(reply), false);
+        reply_t *old_caller = sc->scReply;
+        reply->replyPrev = call_stack_new(REPLY_REF(sc->scReply), false);
+        if (unlikely(old_caller)) {
+            old_caller->replyNext = call_stack_new(REPLY_REF(reply), false);
+        }
+        reply->replyNext = call_stack_new(SC_REF(sc), true);
+        sc->scReply = reply;
+    } else {
+        /* No donation, so the reply is not pushed on the call stack */
+        reply->replyPrev = call_stack_new(0, false);
+        reply->replyNext = call_stack_new(0, false);
     }
-    reply->replyNext = call_stack_new(SC_REF(sc), true);
-    sc->scReply = reply;
 #else
     /* Get sender reply slot */
     cte_t *replySlot = TCB_PTR_CTE_PTR(NODE_STATE(ksCurThread), tcbReply);
@@ -359,17 +754,95 @@ void NORETURN fastpath_vm_fault(vm_fault_type_t type)
     mdb_node_ptr_set_mdbPrev_np(&callerSlot->cteMDBNode, CTE_REF(replySlot));
     mdb_node_ptr_mset_mdbNext_mdbRevocable_mdbFirstBadged(&replySlot->cteMDBNode, CTE_REF(callerSlot), 1, 1);
 #endif
-    /* Set the message registers for the vm fault*/
-    fastpath_vm_fault_set_mrs(dest);
-
-    /* Generate the msginfo */
-    info = seL4_MessageInfo_new(seL4_Fault_VMFault, 0, 0, seL4_VMFault_Length);
+    /* Set the message registers for the fault and generate the msginfo */
+    switch (fault_type) {
+    case seL4_Fault_VMFault:
+        fastpath_vm_fault_set_mrs(dest);
+        info = seL4_MessageInfo_new(seL4_Fault_VMFault, 0, 0, seL4_VMFault_Length);
+        break;
+    case seL4_Fault_UnknownSyscall:
+        fastpath_unknown_syscall_set_mrs(dest);
+        info = seL4_MessageInfo_new(seL4_Fault_UnknownSyscall, 0, 0, seL4_UnknownSyscall_Length);
+        break;
+    default:
+        fastpath_user_exception_set_mrs(dest);
+        info = seL4_MessageInfo_new(seL4_Fault_UserException, 0, 0, seL4_UserException_Length);
+        break;
+    }
 
     /* Set the fault handler to running */
     thread_state_ptr_set_tsType_np(&dest->tcbState, ThreadState_Running);
-    switchToThread_fp(dest, cap_pd, stored_hw_asid);
     msgInfo = wordFromMessageInfo(seL4_MessageInfo_set_capsUnwrapped(info, 0));
 
+#ifdef CONFIG_KERNEL_MCS
+    if (dest_sc != NULL) {
+        if (enqueue_dest) {
+            /* The handler doesn't preempt everything else that is ready, so
+             * let the scheduler pick the next thread now that we've blocked */
+            setRegister(dest, badgeRegister, badge);
+            setRegister(dest, msgInfoRegister, msgInfo);
+            /* As in sendIPC, the head refill of a sporadic handler starts now */
+            if (sc_sporadic(dest_sc)) {
+                refill_unblock_check(dest_sc);
+            }
+            SCHED_ENQUEUE(dest);
+            rescheduleRequired();
+            schedule();
+            activateThread();
+            restore_user_context();
+        }
+
+        /* As in sendIPC, the head refill of a sporadic handler starts now */
+        if (sc_sporadic(dest_sc)) {
+            assert(dest_sc != NODE_STATE(ksCurSC));
+            refill_unblock_check(dest_sc);
+        }
+
+        /* Equivalent to switchSchedContext, ksConsumed was updated above */
+        if (sc_constant_bandwidth(dest_sc)) {
+            refill_unblock_check(dest_sc);
+        }
+        commitTime();
+        NODE_STATE(ksCurSC) = dest_sc;
+    }
+#endif
+
+    switchToThread_fp(dest, cap_pd, stored_hw_asid);
+
+#ifdef CONFIG_KERNEL_MCS
+    if (dest_sc != NULL) {
+        setNextInterrupt();
+        NODE_STATE(ksReprogram) = false;
+    }
+#endif
+
     fastpath_restore(badge, msgInfo, NODE_STATE(ksCurThread));
 }
+
+#ifdef CONFIG_ARCH_ARM
+static inline
+FORCE_INLINE
+#endif
+void NORETURN fastpath_vm_fault(vm_fault_type_t type)
+{
+    fastpath_fault(seL4_Fault_VMFault, type);
+}
+
+#ifdef CONFIG_ARCH_ARM
+static inline
+FORCE_INLINE
+#endif
+void NORETURN fastpath_unknown_syscall(syscall_t syscall)
+{
+    fastpath_fault(seL4_Fault_UnknownSyscall, syscall);
+}
+
+#ifdef CONFIG_ARCH_ARM
+static inline
+FORCE_INLINE
+#endif
+void NORETURN fastpath_user_exception(word_t number)
+{
+    fastpath_fault(seL4_Fault_UserException, number);
+}
 #endif
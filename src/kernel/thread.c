@@ -75,7 +75,11 @@ void setNextInterrupt(void)
 
     if (NODE_STATE(ksReleaseHead) != NULL)
     {
+#ifdef CONFIG_RELEASE_SLACK
+        next_interrupt = MIN(tcbReleaseDeadline(), next_interrupt);
+#else
         next_interrupt = MIN(refill_head(NODE_STATE(ksReleaseHead)->tcbSchedContext)->rTime, next_interrupt);
+#endif
     }
 
     setDeadline(next_interrupt - getTimerPrecision());
@@ -139,6 +143,11 @@ void endTimeslice(bool_t can_timeout_fault)
 #ifdef CONFIG_KERNEL_MCS
 void awaken(void)
 {
+#if defined(CONFIG_RELEASE_SLACK) && defined(CONFIG_BENCHMARK_TRACK_UTILISATION)
+    bool_t released = false;
+    ticks_t covered = 0;
+#endif
+
     while (unlikely(NODE_STATE(ksReleaseHead) != NULL && refill_ready(NODE_STATE(ksReleaseHead)->tcbSchedContext)))
     {
         tcb_t *awakened = tcbReleaseDequeue();
@@ -150,7 +159,24 @@ void awaken(void)
         SMP_COND_STATEMENT(assert(awakened->tcbAffinity == getCurrentCPUIndex()));
         /* threads HEAD refill should always be >= MIN_BUDGET */
         assert(refill_sufficient(awakened->tcbSchedContext, 0));
+#if defined(CONFIG_RELEASE_SLACK) && defined(CONFIG_BENCHMARK_TRACK_UTILISATION)
+        /* Without slack, the interrupt for an earlier release of this batch
+         * would also have released everything up to a kernel WCET after it.
+         * Threads are released in order, so a release past that would have
+         * needed a timer interrupt of its own. */
+        if (!released || refill_head(awakened->tcbSchedContext)->rTime > covered)
+        {
+            if (released)
+            {
+                NODE_STATE(benchmark_coalesced_releases)++;
+            }
+            covered = refill_head(awakened->tcbSchedContext)->rTime + getKernelWcetTicks();
+        }
+#endif
         possibleSwitchTo(awakened);
+#if defined(CONFIG_RELEASE_SLACK) && defined(CONFIG_BENCHMARK_TRACK_UTILISATION)
+        released = true;
+#endif
         /* changed head of release queue -> need to reprogram */
         NODE_STATE(ksReprogram) = true;
     }
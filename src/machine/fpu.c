@@ -11,12 +11,20 @@
 #include <arch/object/structures.h>
 
 #ifdef CONFIG_HAVE_FPU
-/* Switch the owner of the FPU to the given thread on local core. */
+/* Switch the owner of the FPU to the given thread on local core. This is only
+ * done lazily, from the FPU fault of the new owner, and with dirty tracking
+ * skips saving an owner that left its state clean. */
 void switchLocalFpuOwner(user_fpu_state_t *new_owner)
 {
     enableFpu();
     if (NODE_STATE(ksActiveFPUState)) {
+#ifdef CONFIG_FPU_DIRTY_TRACKING
+        if (isFpuStateDirty()) {
+            saveFpuState(NODE_STATE(ksActiveFPUState));
+        }
+#else
         saveFpuState(NODE_STATE(ksActiveFPUState));
+#endif
     }
     if (new_owner) {
         NODE_STATE(ksFPURestoresSinceSwitch) = 0;
@@ -24,6 +32,9 @@ void switchLocalFpuOwner(user_fpu_state_t *new_owner)
     } else {
         disableFpu();
     }
+#ifdef CONFIG_FPU_DIRTY_TRACKING
+    clearFpuStateDirty();
+#endif
     NODE_STATE(ksActiveFPUState) = new_owner;
 }
 
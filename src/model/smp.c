@@ -7,6 +7,10 @@
 #include <config.h>
 #include <model/smp.h>
 #include <object/tcb.h>
+#ifdef CONFIG_WORK_STEALING
+#include <kernel/thread.h>
+#include <smp/ipi.h>
+#endif
 
 #ifdef ENABLE_SMP_SUPPORT
 
@@ -20,7 +24,96 @@ void migrateTCB(tcb_t *tcb, word_t new_core)
 #ifdef CONFIG_DEBUG_BUILD
     tcbDebugAppend(tcb);
 #endif
+#if defined(CONFIG_WORK_STEALING) && defined(CONFIG_BENCHMARK_TRACK_UTILISATION)
+    NODE_STATE(benchmark_migrations)++;
+#endif
+}
+
+#ifdef CONFIG_WORK_STEALING
+/* Returns a migratable thread of the highest priority queued on the core, if
+ * that priority is not above the one of its current thread, as the core would
+ * otherwise switch to it itself */
+static tcb_t *stealCandidate(word_t core)
+{
+    tcb_t *cur = NODE_STATE_ON_CORE(ksCurThread, core);
+    word_t l1index, l2bitmap;
+    prio_t prio;
+    tcb_t *thread;
+
+    if (cur == NODE_STATE_ON_CORE(ksIdleThread, core) ||
+        NODE_STATE_ON_CORE(ksReadyQueuesL1Bitmap, core)[ksCurDomain] == 0) {
+        return NULL;
+    }
+
+    l1index = wordBits - 1 - clzl(NODE_STATE_ON_CORE(ksReadyQueuesL1Bitmap, core)[ksCurDomain]);
+    l2bitmap = NODE_STATE_ON_CORE(ksReadyQueuesL2Bitmap, core)[ksCurDomain][invert_l1index(l1index)];
+    prio = l1index_to_prio(l1index) | (wordBits - 1 - clzl(l2bitmap));
+    if (prio > cur->tcbPriority) {
+        return NULL;
+    }
+
+    thread = NODE_STATE_ON_CORE(ksReadyQueues, core)[ready_queues_index(ksCurDomain, prio)].head;
+    for (; thread != NULL; thread = thread->tcbSchedNext) {
+        if (thread->tcbMigratable) {
+            return thread;
+        }
+    }
+    return NULL;
+}
+
+/* Called on an idle core when it is kicked, pulls one thread from the first
+ * other core that has one waiting */
+void stealWork(void)
+{
+    word_t core = getCurrentCPUIndex();
+    word_t i;
+
+    NODE_STATE(ksStealPending) = false;
+    if (NODE_STATE(ksCurThread) != NODE_STATE(ksIdleThread) ||
+        NODE_STATE(ksReadyQueuesL1Bitmap)[ksCurDomain] != 0) {
+        return;
+    }
+
+    for (i = 1; i < ksNumCPUs; i++) {
+        word_t victim = (core + i) % ksNumCPUs;
+        tcb_t *thread = stealCandidate(victim);
+
+        if (thread != NULL) {
+            tcbSchedDequeue(thread);
+            migrateTCB(thread, core);
+            SCHED_ENQUEUE(thread);
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+            NODE_STATE(benchmark_steals)++;
+#endif
+            return;
+        }
+    }
+}
+
+/* Called on the way out of the kernel, kicks one idle core if this core has a
+ * migratable thread waiting. An idle core is kicked at most once until it has
+ * looked for work. */
+void stealKick(void)
+{
+    word_t core = getCurrentCPUIndex();
+    word_t i;
+
+    if (likely(stealCandidate(core) == NULL)) {
+        return;
+    }
+
+    for (i = 1; i < ksNumCPUs; i++) {
+        word_t target = (core + i) % ksNumCPUs;
+
+        if (NODE_STATE_ON_CORE(ksCurThread, target) == NODE_STATE_ON_CORE(ksIdleThread, target) &&
+            !NODE_STATE_ON_CORE(ksStealPending, target)) {
+            NODE_STATE_ON_CORE(ksStealPending, target) = true;
+            doMaskReschedule(BIT(target));
+            return;
+        }
+    }
 }
+#endif /* CONFIG_WORK_STEALING */
 
 cpu_id_t getCurrentCPUIndex(void)
 {
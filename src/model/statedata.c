@@ -35,6 +35,10 @@ compile_assert(ksReadyQueuesL1BitmapBigEnough, (L2_BITMAP_SIZE - 1) <= wordBits)
 #ifdef CONFIG_KERNEL_MCS
 /* Head of the queue of threads waiting for their budget to be replenished */
 UP_STATE_DEFINE(tcb_t *, ksReleaseHead);
+#ifdef CONFIG_RELEASE_HEAP
+/* Number of threads in the release heap rooted at ksReleaseHead */
+UP_STATE_DEFINE(word_t, ksReleaseHeapSize);
+#endif
 #endif
 
 /* Current thread TCB pointer */
@@ -54,6 +58,14 @@ UP_STATE_DEFINE(user_fpu_state_t *, ksActiveFPUState);
 
 UP_STATE_DEFINE(word_t, ksFPURestoresSinceSwitch);
 #endif /* CONFIG_HAVE_FPU */
+#ifdef CONFIG_RISCV_EXT_V
+/* Thread whose state is in the vector registers, or NULL */
+UP_STATE_DEFINE(tcb_t *, ksActiveVectorOwner);
+#endif
+#ifdef CONFIG_ASYNC_EXECUTOR
+/* Executors queued on this core by seL4_AsyncSubmit */
+UP_STATE_DEFINE(executor_queue_t, ksExecutorQueue);
+#endif
 #ifdef CONFIG_KERNEL_MCS
 /* the amount of time passed since the kernel time was last updated */
 UP_STATE_DEFINE(ticks_t, ksConsumed);
@@ -76,6 +88,52 @@ UP_STATE_DEFINE(timestamp_t, benchmark_end_time);
 UP_STATE_DEFINE(timestamp_t, benchmark_kernel_time);
 UP_STATE_DEFINE(timestamp_t, benchmark_kernel_number_entries);
 UP_STATE_DEFINE(timestamp_t, benchmark_kernel_number_schedules);
+#ifdef CONFIG_CROSSCORE_FASTPATH
+UP_STATE_DEFINE(uint64_t, benchmark_crosscore_fastpath);
+UP_STATE_DEFINE(uint64_t, benchmark_crosscore_fastpath_cycles);
+#endif
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+UP_STATE_DEFINE(uint64_t, benchmark_cap_cache_hits);
+UP_STATE_DEFINE(uint64_t, benchmark_cap_cache_misses);
+#endif
+#ifdef CONFIG_BATCH_INVOCATION
+UP_STATE_DEFINE(uint64_t, benchmark_batch_invocations);
+UP_STATE_DEFINE(uint64_t, benchmark_batch_cycles);
+#endif
+#ifdef CONFIG_ASYNC_EXECUTOR
+UP_STATE_DEFINE(uint64_t, benchmark_async_invocations);
+UP_STATE_DEFINE(uint64_t, benchmark_async_completions);
+UP_STATE_DEFINE(uint64_t, benchmark_async_cycles);
+#endif
+#ifdef CONFIG_RELEASE_SLACK
+UP_STATE_DEFINE(uint64_t, benchmark_coalesced_releases);
+#endif
+#ifdef CONFIG_WORK_STEALING
+UP_STATE_DEFINE(uint64_t, benchmark_steals);
+UP_STATE_DEFINE(uint64_t, benchmark_migrations);
+#endif
+#ifdef CONFIG_WAKEUP_INBOX
+UP_STATE_DEFINE(uint64_t, benchmark_inbox_wakeups);
+#endif
+#ifdef CONFIG_TARGETED_REMOTE_CALLS
+UP_STATE_DEFINE(uint64_t, benchmark_remote_calls);
+#endif
+#ifdef CONFIG_ARCH_RISCV
+UP_STATE_DEFINE(uint64_t, benchmark_timer_programs);
+UP_STATE_DEFINE(uint64_t, benchmark_timer_program_cycles);
+UP_STATE_DEFINE(uint64_t, benchmark_ipi_sends);
+UP_STATE_DEFINE(uint64_t, benchmark_ipi_send_cycles);
+UP_STATE_DEFINE(uint64_t, benchmark_timer_irqs);
+UP_STATE_DEFINE(uint64_t, benchmark_timer_irq_cycles);
+UP_STATE_DEFINE(uint64_t, benchmark_trap_entries);
+UP_STATE_DEFINE(uint64_t, benchmark_trap_entry_cycles);
+UP_STATE_DEFINE(uint64_t, benchmark_ipc_trap_entries);
+UP_STATE_DEFINE(uint64_t, benchmark_ipc_trap_entry_cycles);
+#endif
+#ifdef CONFIG_RISCV_IRQ_BATCH
+UP_STATE_DEFINE(uint64_t, benchmark_irq_batch_entries);
+UP_STATE_DEFINE(uint64_t, benchmark_irq_batch_irqs);
+#endif
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
 
 /* Units of work we have completed since the last time we checked for
@@ -104,6 +162,13 @@ extern word_t ksDomScheduleIdx;
 /* Only used by lockTLBEntry */
 word_t tlbLockCount = 0;
 
+#ifdef CONFIG_FASTPATH_CAP_CACHE
+/* Bumped whenever a CSpace may change shape, including from the syscall entry
+ * in assembly. It starts at 1 so that the zeroed cache of a new thread is
+ * stale. */
+word_t ksFastpathCapCacheGeneration = 1;
+#endif
+
 /* Idle thread. */
 SECTION("._idle_thread") char ksIdleThreadTCB[CONFIG_MAX_NUM_NODES][BIT(seL4_TCBBits)] ALIGN(BIT(TCB_SIZE_BITS));
 
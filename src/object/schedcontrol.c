@@ -51,6 +51,11 @@ static exception_t invokeSchedControl_ConfigureFlags(sched_context_t *target, wo
         refill_new(target, max_refills, budget, period);
     }
 
+#ifdef CONFIG_RELEASE_SLACK
+    /* the refills are set up, so scRefillMax now points at the slack slot */
+    *sc_slack(target) = usToTicks(flags >> seL4_SchedContext_SlackShift);
+#endif
+
 #ifdef ENABLE_SMP_SUPPORT
     target->scCore = core;
     if (target->scTcb) {
@@ -130,10 +135,27 @@ static exception_t decodeSchedControl_ConfigureFlags(word_t length, cap_t cap, w
         return EXCEPTION_SYSCALL_ERROR;
     }
 
-    if (extra_refills + MIN_REFILLS > refill_absolute_max(targetCap)) {
+#ifdef CONFIG_RELEASE_SLACK
+    if ((flags >> seL4_SchedContext_SlackShift) > MAX_PERIOD_US) {
+        userError("SchedControl_ConfigureFlags: slack out of range.");
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 0;
+        current_syscall_error.rangeErrorMax = MAX_PERIOD_US;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if (unlikely(refill_absolute_max(targetCap) < MIN_REFILLS + SLACK_REFILLS)) {
+        userError("SchedControl_ConfigureFlags: scheduling context too small to hold a slack.");
+        current_syscall_error.type = seL4_InvalidCapability;
+        current_syscall_error.invalidCapNumber = 1;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+#endif
+
+    if (extra_refills + MIN_REFILLS + SLACK_REFILLS > refill_absolute_max(targetCap)) {
         current_syscall_error.type = seL4_RangeError;
         current_syscall_error.rangeErrorMin = 0;
-        current_syscall_error.rangeErrorMax = refill_absolute_max(targetCap) - MIN_REFILLS;
+        current_syscall_error.rangeErrorMax = refill_absolute_max(targetCap) - MIN_REFILLS - SLACK_REFILLS;
         userError("Max refills invalid, got %lu, max %lu",
                   extra_refills,
                   current_syscall_error.rangeErrorMax);
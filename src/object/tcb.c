@@ -53,6 +53,227 @@ void tcbDebugRemove(tcb_t *tcb)
 
 
 #ifdef CONFIG_KERNEL_MCS
+#ifdef CONFIG_RELEASE_HEAP
+/* The release queue of each core is a binary min-heap on the release time of
+ * the head refill, rooted at ksReleaseHead. The heap is a complete binary tree
+ * of the threads themselves, so that it needs no storage beyond the TCBs:
+ * tcbSchedNext and tcbSchedPrev are the left and right child, and the node at
+ * position n (the root being at 1) is found by following the bits of n below
+ * its most significant one from the root, 0 going left and 1 going right. */
+#define releaseLeft(tcb)  ((tcb)->tcbSchedNext)
+#define releaseRight(tcb) ((tcb)->tcbSchedPrev)
+
+static inline ticks_t releaseTime(tcb_t *tcb)
+{
+    return refill_head(tcb->tcbSchedContext)->rTime;
+}
+
+static tcb_t *releaseHeapNode(word_t core, word_t pos)
+{
+    tcb_t *node = NODE_STATE_ON_CORE(ksReleaseHead, core);
+    word_t bit;
+
+    for (bit = wordBits - 1 - clzl(pos); bit > 0; bit--)
+    {
+        node = (pos & BIT(bit - 1)) ? releaseRight(node) : releaseLeft(node);
+    }
+    return node;
+}
+
+/* Points whatever pointed to old, the parent or ksReleaseHead, to new */
+static inline void releaseHeapRelink(word_t core, tcb_t *parent, tcb_t *old, tcb_t *new)
+{
+    if (parent == NULL)
+    {
+        NODE_STATE_ON_CORE(ksReleaseHead, core) = new;
+    }
+    else if (releaseLeft(parent) == old)
+    {
+        releaseLeft(parent) = new;
+    }
+    else
+    {
+        releaseRight(parent) = new;
+    }
+}
+
+/* Exchanges the places of tcb and its parent */
+static void releaseHeapSwapWithParent(word_t core, tcb_t *tcb)
+{
+    tcb_t *parent = tcb->tcbReleaseParent;
+    tcb_t *left = releaseLeft(tcb);
+    tcb_t *right = releaseRight(tcb);
+    tcb_t *sibling;
+
+    releaseHeapRelink(core, parent->tcbReleaseParent, parent, tcb);
+    tcb->tcbReleaseParent = parent->tcbReleaseParent;
+
+    if (releaseLeft(parent) == tcb)
+    {
+        sibling = releaseRight(parent);
+        releaseLeft(tcb) = parent;
+        releaseRight(tcb) = sibling;
+    }
+    else
+    {
+        sibling = releaseLeft(parent);
+        releaseLeft(tcb) = sibling;
+        releaseRight(tcb) = parent;
+    }
+    if (sibling != NULL)
+    {
+        sibling->tcbReleaseParent = tcb;
+    }
+
+    releaseLeft(parent) = left;
+    releaseRight(parent) = right;
+    if (left != NULL)
+    {
+        left->tcbReleaseParent = parent;
+    }
+    if (right != NULL)
+    {
+        right->tcbReleaseParent = parent;
+    }
+    parent->tcbReleaseParent = tcb;
+}
+
+static void releaseHeapSiftUp(word_t core, tcb_t *tcb)
+{
+    while (tcb->tcbReleaseParent != NULL && releaseTime(tcb) < releaseTime(tcb->tcbReleaseParent))
+    {
+        releaseHeapSwapWithParent(core, tcb);
+    }
+}
+
+static void releaseHeapSiftDown(word_t core, tcb_t *tcb)
+{
+    while (true)
+    {
+        tcb_t *child = releaseLeft(tcb);
+
+        if (child == NULL)
+        {
+            return;
+        }
+        if (releaseRight(tcb) != NULL && releaseTime(releaseRight(tcb)) < releaseTime(child))
+        {
+            child = releaseRight(tcb);
+        }
+        if (releaseTime(child) >= releaseTime(tcb))
+        {
+            return;
+        }
+        releaseHeapSwapWithParent(core, child);
+    }
+}
+
+static void releaseHeapRemove(word_t core, tcb_t *tcb)
+{
+    word_t size = NODE_STATE_ON_CORE(ksReleaseHeapSize, core);
+    tcb_t *last = releaseHeapNode(core, size);
+
+    /* the last node has no children, so taking it out keeps the tree complete */
+    releaseHeapRelink(core, last->tcbReleaseParent, last, NULL);
+    NODE_STATE_ON_CORE(ksReleaseHeapSize, core) = size - 1;
+
+    if (last != tcb)
+    {
+        /* the last node takes the place of the removed one */
+        last->tcbReleaseParent = tcb->tcbReleaseParent;
+        releaseLeft(last) = releaseLeft(tcb);
+        releaseRight(last) = releaseRight(tcb);
+        if (releaseLeft(last) != NULL)
+        {
+            releaseLeft(last)->tcbReleaseParent = last;
+        }
+        if (releaseRight(last) != NULL)
+        {
+            releaseRight(last)->tcbReleaseParent = last;
+        }
+        releaseHeapRelink(core, tcb->tcbReleaseParent, tcb, last);
+
+        releaseHeapSiftUp(core, last);
+        releaseHeapSiftDown(core, last);
+    }
+
+    releaseLeft(tcb) = NULL;
+    releaseRight(tcb) = NULL;
+    tcb->tcbReleaseParent = NULL;
+    thread_state_ptr_set_tcbInReleaseQueue(&tcb->tcbState, false);
+}
+
+void tcbReleaseRemove(tcb_t *tcb)
+{
+    word_t core = SMP_TERNARY(tcb->tcbAffinity, 0);
+
+    if (likely(thread_state_get_tcbInReleaseQueue(tcb->tcbState)))
+    {
+        if (NODE_STATE_ON_CORE(ksReleaseHead, core) == tcb)
+        {
+            /* the head has changed, we might need to set a new timeout */
+            NODE_STATE_ON_CORE(ksReprogram, core) = true;
+        }
+        releaseHeapRemove(core, tcb);
+    }
+}
+
+void tcbReleaseEnqueue(tcb_t *tcb)
+{
+    word_t core = SMP_TERNARY(tcb->tcbAffinity, 0);
+    word_t size;
+
+    assert(thread_state_get_tcbInReleaseQueue(tcb->tcbState) == false);
+    assert(thread_state_get_tcbQueued(tcb->tcbState) == false);
+
+    size = NODE_STATE_ON_CORE(ksReleaseHeapSize, core) + 1;
+    NODE_STATE_ON_CORE(ksReleaseHeapSize, core) = size;
+
+    releaseLeft(tcb) = NULL;
+    releaseRight(tcb) = NULL;
+    if (size == 1)
+    {
+        tcb->tcbReleaseParent = NULL;
+        NODE_STATE_ON_CORE(ksReleaseHead, core) = tcb;
+    }
+    else
+    {
+        tcb_t *parent = releaseHeapNode(core, size >> 1);
+
+        tcb->tcbReleaseParent = parent;
+        if (size & 1)
+        {
+            releaseRight(parent) = tcb;
+        }
+        else
+        {
+            releaseLeft(parent) = tcb;
+        }
+        releaseHeapSiftUp(core, tcb);
+    }
+
+    if (NODE_STATE_ON_CORE(ksReleaseHead, core) == tcb)
+    {
+        NODE_STATE_ON_CORE(ksReprogram, core) = true;
+    }
+
+    thread_state_ptr_set_tcbInReleaseQueue(&tcb->tcbState, true);
+}
+
+tcb_t *tcbReleaseDequeue(void)
+{
+    tcb_t *head = NODE_STATE(ksReleaseHead);
+
+    assert(head != NULL);
+    assert(head->tcbReleaseParent == NULL);
+    SMP_COND_STATEMENT(assert(head->tcbAffinity == getCurrentCPUIndex()));
+
+    releaseHeapRemove(CURRENT_CPU_INDEX(), head);
+    NODE_STATE(ksReprogram) = true;
+
+    return head;
+}
+#else
 void tcbReleaseRemove(tcb_t *tcb)
 {
     if (likely(thread_state_get_tcbInReleaseQueue(tcb->tcbState)))
@@ -142,6 +363,66 @@ tcb_t *tcbReleaseDequeue(void)
 
     return detached_head;
 }
+#endif /* CONFIG_RELEASE_HEAP */
+
+#ifdef CONFIG_RELEASE_SLACK
+static inline ticks_t releaseLatest(tcb_t *tcb)
+{
+    return refill_head(tcb->tcbSchedContext)->rTime + *sc_slack(tcb->tcbSchedContext);
+}
+
+/* Returns the latest time the timer can fire at without delaying any thread
+ * in the release queue of this core by more than its slack. This is the
+ * minimum of release time plus slack over the threads released before it, so
+ * only those threads, which are all released by the interrupt, are visited. */
+ticks_t tcbReleaseDeadline(void)
+{
+    tcb_t *tcb = NODE_STATE(ksReleaseHead);
+    ticks_t deadline;
+
+    assert(tcb != NULL);
+    deadline = releaseLatest(tcb);
+#ifdef CONFIG_RELEASE_HEAP
+    /* walk the part of the heap released before the deadline, using the
+     * parent pointers rather than a stack */
+    tcb_t *prev = NULL;
+    while (tcb != NULL)
+    {
+        tcb_t *next = tcb->tcbReleaseParent;
+
+        if (prev == tcb->tcbReleaseParent)
+        {
+            deadline = MIN(deadline, releaseLatest(tcb));
+            if (releaseLeft(tcb) != NULL && releaseTime(releaseLeft(tcb)) <= deadline)
+            {
+                next = releaseLeft(tcb);
+            }
+            else if (releaseRight(tcb) != NULL && releaseTime(releaseRight(tcb)) <= deadline)
+            {
+                next = releaseRight(tcb);
+            }
+        }
+        else if (prev == releaseLeft(tcb))
+        {
+            if (releaseRight(tcb) != NULL && releaseTime(releaseRight(tcb)) <= deadline)
+            {
+                next = releaseRight(tcb);
+            }
+        }
+        prev = tcb;
+        tcb = next;
+    }
+#else
+    for (tcb = tcb->tcbSchedNext;
+         tcb != NULL && refill_head(tcb->tcbSchedContext)->rTime <= deadline;
+         tcb = tcb->tcbSchedNext)
+    {
+        deadline = MIN(deadline, releaseLatest(tcb));
+    }
+#endif
+    return deadline;
+}
+#endif /* CONFIG_RELEASE_SLACK */
 #endif
 
 // cptr_t PURE getExtraCPtr(word_t *bufferPtr, word_t i)
@@ -172,7 +453,6 @@ void remoteQueueUpdate(tcb_t *tcb)
     if (tcb->tcbAffinity != getCurrentCPUIndex() && tcb->tcbDomain == ksCurDomain)
     {
         tcb_t *targetCurThread = NODE_STATE_ON_CORE(ksCurThread, tcb->tcbAffinity);
-        printf("targetCurThread: %ld, %p\n", tcb->tcbAffinity, targetCurThread);
         /* reschedule if the target core is idle or we are waking a higher priority thread (or
          * if a new irq would need to be set on MCS) */
         if (targetCurThread == NODE_STATE_ON_CORE(ksIdleThread, tcb->tcbAffinity) ||
@@ -183,7 +463,6 @@ void remoteQueueUpdate(tcb_t *tcb)
         )
         {
             ARCH_NODE_STATE(ipiReschedulePending) |= BIT(tcb->tcbAffinity);
-            printf("ipiReschedulePending : %ld\n", ARCH_NODE_STATE(ipiReschedulePending));
         }
     }
 }
@@ -206,6 +485,120 @@ void remoteTCBStall(tcb_t *tcb)
     }
 }
 
+#ifdef CONFIG_WAKEUP_INBOX
+/* Pushes the thread onto the inbox of its core. Only the owning core takes
+ * threads off an inbox, and it takes all of them at once, so a push is a
+ * single compare and swap with no ABA problem. */
+static void wakeupInboxPush(tcb_t *tcb, wakeup_mode_t mode)
+{
+    word_t core = tcb->tcbAffinity;
+    tcb_t **inbox = &NODE_STATE_ON_CORE(ksWakeupInbox, core);
+    word_t idle = 0;
+    tcb_t *head;
+
+    /* A thread already in an inbox is looked at again when it is spliced */
+    if (!__atomic_compare_exchange_n(&tcb->tcbWakeupMode, &idle, mode, false,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        return;
+    }
+
+    head = __atomic_load_n(inbox, __ATOMIC_RELAXED);
+    do {
+        tcb->tcbWakeupNext = head;
+    } while (!__atomic_compare_exchange_n(inbox, &head, tcb, true,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    /* The scheduler of the core can't see the inbox, so the core always has to
+     * be kicked. Later pushes share the IPI of the one that found it empty. */
+    if (head == NULL) {
+        ARCH_NODE_STATE(ipiReschedulePending) |= BIT(core);
+    }
+}
+
+/* Replaces tcbSchedEnqueue/tcbSchedAppend followed by remoteQueueUpdate in the
+ * C callers, so that they don't write to the ready queues of another core. The
+ * wakeups of the Rust part of the kernel still do. */
+void wakeupQueue(tcb_t *tcb, wakeup_mode_t mode)
+{
+    if (tcb->tcbAffinity == getCurrentCPUIndex()) {
+        if (mode == WakeupMode_Append) {
+            tcbSchedAppend(tcb);
+        } else {
+            tcbSchedEnqueue(tcb);
+        }
+        return;
+    }
+
+    if (!thread_state_get_tcbQueued(tcb->tcbState)) {
+        wakeupInboxPush(tcb, mode);
+    }
+}
+
+/* Called on the owning core with the lock held, from the reschedule IPI and
+ * on kernel entry */
+void wakeupInboxSplice(void)
+{
+    tcb_t *thread = __atomic_exchange_n(&NODE_STATE(ksWakeupInbox), NULL, __ATOMIC_ACQUIRE);
+    tcb_t *prev = NULL;
+    tcb_t *next;
+    wakeup_mode_t mode;
+
+    /* Reverse the inbox so threads are queued in the order they were woken */
+    for (; thread != NULL; thread = next) {
+        next = thread->tcbWakeupNext;
+        thread->tcbWakeupNext = prev;
+        prev = thread;
+    }
+
+    for (thread = prev; thread != NULL; thread = next) {
+        next = thread->tcbWakeupNext;
+        mode = thread->tcbWakeupMode;
+        thread->tcbWakeupNext = NULL;
+        /* The thread may be pushed again from here on */
+        __atomic_store_n(&thread->tcbWakeupMode, 0, __ATOMIC_RELEASE);
+
+        /* e.g. the thread was suspended or blocked again since it was woken,
+         * or the Rust part of the kernel queued it here directly, whether or
+         * not it has been picked to run since. The current thread is never
+         * queued. */
+        if (!isRunnable(thread) || thread == NODE_STATE(ksCurThread) ||
+            thread_state_get_tcbQueued(thread->tcbState)) {
+            continue;
+        }
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+        NODE_STATE(benchmark_inbox_wakeups)++;
+#endif
+        /* Pushes the thread on to its new core if its affinity changed */
+        wakeupQueue(thread, mode);
+    }
+}
+
+/* Called on deletion, as the inbox would otherwise point to a freed TCB. All
+ * pushes and splices are done with big_kernel_lock held, so unlinking from
+ * outside the owning core is safe here. */
+void wakeupInboxRemove(tcb_t *tcb)
+{
+    tcb_t **link;
+    word_t core;
+
+    if (tcb->tcbWakeupMode == 0) {
+        return;
+    }
+
+    for (core = 0; core < ksNumCPUs; core++) {
+        for (link = &NODE_STATE_ON_CORE(ksWakeupInbox, core); *link != NULL;
+             link = &(*link)->tcbWakeupNext) {
+            if (*link == tcb) {
+                *link = tcb->tcbWakeupNext;
+                tcb->tcbWakeupNext = NULL;
+                tcb->tcbWakeupMode = 0;
+                return;
+            }
+        }
+    }
+}
+#endif /* CONFIG_WAKEUP_INBOX */
+
 #ifndef CONFIG_KERNEL_MCS
 static exception_t invokeTCB_SetAffinity(tcb_t *thread, word_t affinity)
 {
@@ -253,6 +646,27 @@ static UNUSED exception_t decodeSetAffinity(cap_t cap, word_t length, word_t *bu
 #endif
 #endif /* ENABLE_SMP_SUPPORT */
 
+#ifdef CONFIG_WORK_STEALING
+static exception_t invokeTCB_SetMigratable(tcb_t *thread, bool_t migratable)
+{
+    thread->tcbMigratable = migratable;
+    return EXCEPTION_NONE;
+}
+
+exception_t decodeSetMigratable(cap_t cap, word_t length, word_t *buffer)
+{
+    if (length < 1)
+    {
+        userError("TCB SetMigratable: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    return invokeTCB_SetMigratable(TCB_PTR(cap_thread_cap_get_capTCBPtr(cap)),
+                                   getSyscallArg(0, buffer) != 0);
+}
+#endif /* CONFIG_WORK_STEALING */
+
 #ifdef CONFIG_HARDWARE_DEBUG_API
 static exception_t invokeConfigureSingleStepping(bool_t call, word_t *buffer, tcb_t *t,
                                                  uint16_t bp_num, word_t n_instrs)
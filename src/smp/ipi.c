@@ -11,6 +11,8 @@
 #include <mode/smp/ipi.h>
 #include <smp/ipi.h>
 #include <smp/lock.h>
+#include <api/executor.h>
+#include <model/smp.h>
 
 /* This function switches the core it is called on to the idle thread,
  * in order to avoid IPI storms. If the core is waiting on the lock, the actual
@@ -41,20 +43,36 @@ void ipiStallCoreCallback(bool_t irqPath)
         NODE_STATE(ksSchedulerAction) = SchedulerAction_ResumeCurrentThread;
 
         /* Let the cpu requesting this IPI to continue while we waiting on lock */
+#ifdef CONFIG_TARGETED_REMOTE_CALLS
+        /* handleRemoteCalls has already cleared the pending flag, and doesn't
+         * get to complete this call as we don't return */
+        remote_call_complete(getCurrentCPUIndex());
+#else
         big_kernel_lock.node_owners[getCurrentCPUIndex()].ipi = 0;
 #ifdef CONFIG_ARCH_RISCV
         ipi_clear_irq(irq_remote_call_ipi);
 #endif
         ipi_wait(totalCoreBarrier);
+#endif
 
         /* Continue waiting on lock */
         while (big_kernel_lock.node_owners[getCurrentCPUIndex()].next->value != CLHState_Granted) {
+#ifdef CONFIG_TARGETED_REMOTE_CALLS
+            /* Calls queued behind the stall are still in the queue */
+            if (remote_calls_pending(getCurrentCPUIndex())) {
+                /* Multiple calls for similar reason could result in stack overflow */
+                assert(remoteCallQueue[getCurrentCPUIndex()].calls[remoteCallQueue[getCurrentCPUIndex()].head %
+                                                                   REMOTE_CALL_QUEUE_LENGTH].func != IpiRemoteCall_Stall);
+                handleIPI(CORE_IRQ_TO_IRQT(getCurrentCPUIndex(), irq_remote_call_ipi), irqPath);
+            }
+#else
             if (clh_is_ipi_pending(getCurrentCPUIndex())) {
 
                 /* Multiple calls for similar reason could result in stack overflow */
                 assert((IpiRemoteCall_t)remoteCall != IpiRemoteCall_Stall);
                 handleIPI(CORE_IRQ_TO_IRQT(getCurrentCPUIndex(), irq_remote_call_ipi), irqPath);
             }
+#endif
             arch_pause();
         }
 
@@ -82,17 +100,96 @@ void ipiStallCoreCallback(bool_t irqPath)
 void handleIPI(irq_t irq, bool_t irqPath)
 {
     if (IRQT_TO_IRQ(irq) == irq_remote_call_ipi) {
+#ifdef CONFIG_TARGETED_REMOTE_CALLS
+        handleRemoteCalls(irqPath);
+#else
         handleRemoteCall(remoteCall, get_ipi_arg(0), get_ipi_arg(1), get_ipi_arg(2), irqPath);
+#endif
     } else if (IRQT_TO_IRQ(irq) == irq_reschedule_ipi) {
+#ifdef CONFIG_TARGETED_REMOTE_CALLS
+        /* A reschedule IPI sent before the core has taken a remote call one
+         * replaces it in ipiIrq, so pick those calls up here too */
+        handleRemoteCalls(irqPath);
+#endif
         rescheduleRequired();
 #ifdef CONFIG_ARCH_RISCV
         ifence_local();
+#endif
+#ifdef CONFIG_WAKEUP_INBOX
+        wakeupInboxSplice();
+#endif
+#ifdef CONFIG_WORK_STEALING
+        stealWork();
+#endif
+#ifdef CONFIG_ASYNC_EXECUTOR
+        /* The reschedule and async syscall IPIs share the pending IPI of the
+         * core, so each has to do the work of the other */
+        executorQueueDrain();
+    } else if (IRQT_TO_IRQ(irq) == irq_async_syscall_ipi) {
+        rescheduleRequired();
+#ifdef CONFIG_WAKEUP_INBOX
+        wakeupInboxSplice();
+#endif
+        executorQueueDrain();
 #endif
     } else {
         fail("Invalid IPI");
     }
 }
 
+#ifdef CONFIG_TARGETED_REMOTE_CALLS
+/* Queues the call for the core and returns the head the core has to reach for
+ * the call to be complete. Only a core that has already cleared its pending
+ * flag needs another IPI, the others will find the call in their queue. */
+static word_t remote_call_post(IpiRemoteCall_t func, word_t data1, word_t data2, word_t data3, word_t core)
+{
+    remote_call_queue_t *queue = &remoteCallQueue[core];
+    /* Not an atomic increment: only the holder of big_kernel_lock posts
+     * calls, which serialises the producers of every queue */
+    word_t tail = queue->tail;
+    remote_call_t *call;
+
+    assert(tail - __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE) < REMOTE_CALL_QUEUE_LENGTH);
+    call = &queue->calls[tail % REMOTE_CALL_QUEUE_LENGTH];
+    call->func = func;
+    call->args[0] = data1;
+    call->args[1] = data2;
+    call->args[2] = data3;
+    __atomic_store_n(&queue->tail, tail + 1, __ATOMIC_RELEASE);
+
+    /* pairs with the fence in handleRemoteCalls, either the core sees the new
+     * tail or we see its cleared flag */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    NODE_STATE(benchmark_remote_calls)++;
+#endif
+    if (!clh_is_ipi_pending(core)) {
+        ipi_send_mask(CORE_IRQ_TO_IRQT(0, irq_remote_call_ipi), BIT(core), true);
+    }
+
+    return tail + 1;
+}
+
+void doRemoteMaskOp(IpiRemoteCall_t func, word_t data1, word_t data2, word_t data3, word_t mask)
+{
+    word_t done[CONFIG_MAX_NUM_NODES];
+    word_t pending, core;
+
+    mask &= ~BIT(getCurrentCPUIndex());
+    for (pending = mask; pending != 0; pending &= ~BIT(core)) {
+        core = wordBits - 1 - clzl(pending);
+        done[core] = remote_call_post(func, data1, data2, data3, core);
+    }
+
+    /* Wait for each target on its own queue rather than on a shared barrier */
+    for (pending = mask; pending != 0; pending &= ~BIT(core)) {
+        core = wordBits - 1 - clzl(pending);
+        while ((sword_t)(__atomic_load_n(&remoteCallQueue[core].head, __ATOMIC_ACQUIRE) - done[core]) < 0) {
+            arch_pause();
+        }
+    }
+}
+#else
 void doRemoteMaskOp(IpiRemoteCall_t func, word_t data1, word_t data2, word_t data3, word_t mask)
 {
     /* make sure the current core is not set in the mask */
@@ -109,6 +206,7 @@ void doRemoteMaskOp(IpiRemoteCall_t func, word_t data1, word_t data2, word_t dat
         ipi_wait(totalCoreBarrier);
     }
 }
+#endif /* CONFIG_TARGETED_REMOTE_CALLS */
 
 void doMaskReschedule(word_t mask)
 {
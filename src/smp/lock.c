@@ -10,6 +10,12 @@
 #ifdef ENABLE_SMP_SUPPORT
 
 clh_lock_t big_kernel_lock ALIGN(L1_CACHE_LINE_SIZE);
+#ifdef CONFIG_FINE_GRAINED_LOCKING
+fine_grained_lock_t fine_grained_lock ALIGN(L1_CACHE_LINE_SIZE);
+#endif
+#ifdef CONFIG_BENCHMARK_GENERIC
+benchmark_lock_stats_t ksLockStats[CONFIG_MAX_NUM_NODES] ALIGN(L1_CACHE_LINE_SIZE);
+#endif
 
 BOOT_CODE void clh_lock_init(void)
 {